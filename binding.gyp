@@ -2,15 +2,27 @@
   "target_defaults": {
     "sources": [
       "src/NuoJsAddon.cpp",
+      "src/NuoJsArrow.cpp",
+      "src/NuoJsBinds.cpp",
+      "src/NuoJsColumnar.cpp",
       "src/NuoJsConnection.cpp",
+      "src/NuoJsCursor.cpp",
+      "src/NuoJsDateCodec.cpp",
+      "src/NuoJsDecimal.cpp",
       "src/NuoJsDriver.cpp",
       "src/NuoJsErrMsg.cpp",
       "src/NuoJsJson.cpp",
+      "src/NuoJsLob.cpp",
       "src/NuoJsNan.cpp",
       "src/NuoJsNanDate.cpp",
       "src/NuoJsOptions.cpp",
       "src/NuoJsParams.cpp",
       "src/NuoJsResultSet.cpp",
+      "src/NuoJsRowBatch.cpp",
+      "src/NuoJsRowReader.cpp",
+      "src/NuoJsRowWriter.cpp",
+      "src/NuoJsStatement.cpp",
+      "src/NuoJsStatementCache.cpp",
       "src/NuoJsTypes.cpp",
       "src/NuoJsValue.cpp",
       "src/NuoJsData.cpp"
@@ -6,6 +6,7 @@
 'use strict';
 
 var ResultSet = require('./resultset')
+var Statement = require('./statement')
 
 var assert = require('assert');
 var util = require('util');
@@ -42,6 +43,62 @@ function execute() {
 
 var executePromisified = util.promisify(execute);
 
+function executeBatch() {
+  var self = this;
+  var args = [].slice.call(arguments);
+  assert(args.length > 1);
+  self._executeBatch.apply(self, args);
+}
+
+var executeBatchPromisified = util.promisify(executeBatch);
+
+function executeColumns() {
+  var self = this;
+  var args = [].slice.call(arguments);
+  assert(args.length > 1);
+  self._executeColumns.apply(self, args);
+}
+
+var executeColumnsPromisified = util.promisify(executeColumns);
+
+function loadFrom() {
+  var self = this;
+  var args = [].slice.call(arguments);
+  assert(args.length > 1);
+  self._loadFrom.apply(self, args);
+}
+
+var loadFromPromisified = util.promisify(loadFrom);
+
+function prepare() {
+  var self = this;
+  var args = [].slice.call(arguments);
+  assert(args.length > 0);
+
+  var cbIdx = 0;
+  do {
+    if (typeof args[cbIdx] === 'function') {
+      break;
+    }
+    cbIdx++;
+  } while (cbIdx < args.length);
+  assert(typeof args[cbIdx] === 'function');
+  var callback = args[cbIdx];
+
+  var extension = function (err, instance) {
+    if (err) {
+      callback(err);
+      return;
+    }
+    Statement.extend(instance, self, self._driver);
+    callback(null, instance);
+  };
+  args[cbIdx] = extension;
+  self._prepare.apply(self, args);
+}
+
+var preparePromisified = util.promisify(prepare);
+
 function close(callback) {
   var self = this;
   self._close(function (err) {
@@ -108,6 +165,38 @@ function extend(connection, driver) {
         enumerable: true,
         writable: true
       },
+      _executeBatch: {
+        value: connection.executeBatch
+      },
+      executeBatch: {
+        value: executeBatchPromisified,
+        enumerable: true,
+        writable: true
+      },
+      _executeColumns: {
+        value: connection.executeColumns
+      },
+      executeColumns: {
+        value: executeColumnsPromisified,
+        enumerable: true,
+        writable: true
+      },
+      _loadFrom: {
+        value: connection.loadFrom
+      },
+      loadFrom: {
+        value: loadFromPromisified,
+        enumerable: true,
+        writable: true
+      },
+      _prepare: {
+        value: connection.prepare
+      },
+      prepare: {
+        value: preparePromisified,
+        enumerable: true,
+        writable: true
+      },
     }
   );
 }
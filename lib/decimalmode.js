@@ -0,0 +1,14 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+const DecimalMode = {
+  DECIMALS_AS_STRING: 0,
+  DECIMALS_AS_NUMBER: 1,
+  DECIMALS_AS_BIGINT: 2,
+}
+
+module.exports = DecimalMode;
@@ -14,6 +14,9 @@ const { Rest } = require("./rest");
 var addon = require('bindings')('nuodb.node');
 
 var Connection = require('./connection')
+var Lob = require('./lob');
+
+Lob.extend(addon.Lob);
 
 var assert = require('assert');
 var util = require('util');
@@ -8,7 +8,8 @@
 var Driver = require('./driver');
 var Isolation = require('./isolation');
 var RowMode = require('./rowmode');
+var DecimalMode = require('./decimalmode');
 var Pool = require('./pool');
 var Rest = require('./rest');
 
-module.exports = { Driver, Isolation, RowMode, Pool, Rest: Rest.Rest };
+module.exports = { Driver, Isolation, RowMode, DecimalMode, Pool, Rest: Rest.Rest };
@@ -0,0 +1,78 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var util = require('util');
+var { Readable } = require('stream');
+var { StringDecoder } = require('string_decoder');
+
+// read returns the next chunk of the LOB as a Buffer, or null at the end.
+function read() {
+  var self = this;
+  var args = [].slice.call(arguments);
+  self._read.apply(self, args);
+}
+
+var readPromisified = util.promisify(read);
+
+// getString reads the rest of the LOB into a string.
+async function getString() {
+  var decoder = new StringDecoder('utf8');
+  var text = '';
+  var chunk;
+  while ((chunk = await this.read()) !== null) {
+    text += decoder.write(chunk);
+  }
+  return text + decoder.end();
+}
+
+// stream returns a Readable of the rest of the LOB, as strings. Chunks are
+// only read from the database as the stream is consumed.
+function stream() {
+  var self = this;
+  var readable = new Readable({
+    highWaterMark: 64 * 1024,
+    read: function (size) {
+      self._read(size, function (err, chunk) {
+        if (err) {
+          readable.destroy(err);
+          return;
+        }
+        readable.push(chunk);
+      });
+    }
+  });
+  readable.setEncoding('utf8');
+  return readable;
+}
+
+function extend(Lob) {
+  Object.defineProperties(
+    Lob.prototype,
+    {
+      _read: {
+        value: Lob.prototype.read
+      },
+      read: {
+        value: readPromisified,
+        enumerable: true,
+        writable: true
+      },
+      getString: {
+        value: getString,
+        enumerable: true,
+        writable: true
+      },
+      stream: {
+        value: stream,
+        enumerable: true,
+        writable: true
+      },
+    }
+  );
+}
+
+module.exports.extend = extend;
@@ -11,7 +11,12 @@ const GET_ROWS_TYPE_BLOCKING = 'BLOCKING'
 const GET_ROWS_TYPE_MIN_BLOCKING = 'MIN_BLOCKING'
 
 var util = require('util');
+var { Readable } = require('stream');
 const loopDefer = require('./loopDefer');
+const RowMode = require('./rowmode');
+
+// rows fetched per batch by a stream unless the caller asks otherwise
+const STREAM_BATCH_SIZE = 1000;
 
 function close(callback) {
   var self = this;
@@ -35,11 +40,19 @@ function getRows() {
   } while (cbIdx < args.length);
   var callback = args[cbIdx];
 
+  // rows already fetched, such as the first batch returned by execute,
+  // are handed back without a trip to a worker thread
+  var buffered = self._getBufferedRows(typeof args[0] === 'number' ? args[0] : 0, args[1] === true);
+  if (buffered !== undefined) {
+    process.nextTick(callback, null, buffered);
+    return;
+  }
+
   var extension = function (err, instance) {
     if (err) {
       callback(err);
+      return;
     }
-    // add future caching support here... (streams)
     callback(null, instance);
   };
   args[cbIdx] = extension;
@@ -72,6 +85,18 @@ function nonBlockingGetRows(){
   // default values
   numRows = numRows ?? 0;
   batchSize = batchSize ?? 1000;
+
+  // columns, and JSON text, are returned from a single fetch; they are
+  // built off the main event loop, so there is nothing to spread over it
+  const rowMode = this._getRowMode();
+  if (rowMode === RowMode.ROWS_AS_COLUMNS || rowMode === RowMode.ROWS_AS_JSON) {
+    const columns = getRowsPromisified.call(this, numRows);
+    if (callback) {
+      columns.then((result) => callback(null, result), callback);
+    }
+    return columns;
+  }
+
   return loopDefer({
     props: [],
     // setup: (p) => {console.log('setup exec'); return p},
@@ -81,8 +106,9 @@ function nonBlockingGetRows(){
       const rowsNeeded = numRows === 0 ? batchSize : numRows - rows.length;
       const rowsToGet = Math.min(rowsNeeded, batchSize)
 
-      // get the rows and add them to props.rows.
-      const nextBatch = await getRowsPromisified.call(this,rowsToGet);
+      // get the rows and add them to props.rows; later batches continue the
+      // request, whose rows together are bounded by maxBufferedBytes
+      const nextBatch = await getRowsPromisified.call(this, rowsToGet, rows.length > 0);
       const totalRows = rows.push(...nextBatch);
 
       const getMoreRows = !( // stop only if
@@ -98,6 +124,98 @@ function nonBlockingGetRows(){
   });
 }
 
+// stream returns a Readable of the rows of the result set. The next batch is
+// only fetched once the previous one has been consumed, so that memory stays
+// bounded by the batch size however many rows there are. The result set is
+// closed after the last row, on error, or when the stream is destroyed; a
+// close while a batch is being fetched waits for the fetch to finish.
+function stream(options) {
+  var self = this;
+  var batchSize = (options && options.batchSize) || STREAM_BATCH_SIZE;
+  var reading = false;
+  var pendingClose = null;
+  var readable = new Readable({
+    objectMode: true,
+    // a batch is pushed whole, so the next read starts once it is drained
+    highWaterMark: 1,
+    read: function () {
+      reading = true;
+      getRows.call(self, batchSize, function (err, rows) {
+        reading = false;
+        if (pendingClose) {
+          pendingClose();
+          return;
+        }
+        if (readable.destroyed) {
+          return;
+        }
+        if (err) {
+          readable.destroy(err);
+          return;
+        }
+        // in JSON mode each chunk is the text of a batch, the last one
+        // empty; in columns mode each chunk is a batch of columns
+        if (typeof rows === 'string') {
+          readable.push(rows === '[]' ? null : rows);
+          return;
+        }
+        var count = Array.isArray(rows) ? rows.length : rows.rows;
+        if (Array.isArray(rows)) {
+          for (var i = 0; i < rows.length; i++) {
+            readable.push(rows[i]);
+          }
+        } else if (count > 0) {
+          readable.push(rows);
+        }
+        if (count < batchSize) {
+          readable.push(null);
+        }
+      });
+    },
+    destroy: function (err, callback) {
+      var close = function () {
+        self._close(function (closeErr) {
+          callback(err || closeErr);
+        });
+      };
+      if (reading) {
+        pendingClose = close;
+      } else {
+        close();
+      }
+    }
+  });
+  return readable;
+}
+
+// Iterating a result set with for await streams its rows; leaving the loop
+// early closes the result set.
+function asyncIterator() {
+  return this.stream()[Symbol.asyncIterator]();
+}
+
+// exportTo writes the remaining rows to a file path, or an open file
+// descriptor, as CSV or NDJSON. The rows are fetched and formatted on a
+// worker thread and never become JS values; the counts of rows and bytes
+// written are returned once the export is complete.
+function exportTo(target, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = {};
+  }
+  this._exportTo(target, options || {}, callback);
+}
+
+var exportToPromisified = util.promisify(exportTo);
+
+// getArrow returns the remaining rows as a Buffer holding an Arrow IPC
+// stream, built column by column on a worker thread.
+function getArrow(callback) {
+  this._getArrow(callback);
+}
+
+var getArrowPromisified = util.promisify(getArrow);
+
 function extend(resultset, connection, driver) {
   Object.defineProperties(
     resultset,
@@ -119,6 +237,12 @@ function extend(resultset, connection, driver) {
       _getRows: {
         value: resultset.getRows
       },
+      _getBufferedRows: {
+        value: resultset.getBufferedRows
+      },
+      _getRowMode: {
+        value: resultset.getRowMode
+      },
       getRows: {
         value: process.env[GET_ROWS_ENV_VAR] === GET_ROWS_TYPE_BLOCKING ? getRowsPromisified : nonBlockingGetRows,
         enumerable: true,
@@ -127,6 +251,31 @@ function extend(resultset, connection, driver) {
       getRowsStyle: {
         value: process.env[GET_ROWS_ENV_VAR] ?? GET_ROWS_TYPE_MIN_BLOCKING,
         writable: false
+      },
+      _exportTo: {
+        value: resultset.exportTo
+      },
+      exportTo: {
+        value: exportToPromisified,
+        enumerable: true,
+        writable: true
+      },
+      _getArrow: {
+        value: resultset.getArrow
+      },
+      getArrow: {
+        value: getArrowPromisified,
+        enumerable: true,
+        writable: true
+      },
+      stream: {
+        value: stream,
+        enumerable: true,
+        writable: true
+      },
+      [Symbol.asyncIterator]: {
+        value: asyncIterator,
+        writable: true
       }
     }
   );
@@ -8,6 +8,9 @@
 const RowMode = {
   ROWS_AS_ARRAY: 0,
   ROWS_AS_OBJECT: 1,
+  ROWS_AS_COLUMNS: 2,
+  ROWS_AS_JSON: 3,
+  ROWS_AS_LAZY_OBJECT: 4,
 }
 
 module.exports = RowMode;
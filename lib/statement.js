@@ -0,0 +1,81 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var ResultSet = require('./resultset')
+
+var util = require('util');
+
+function execute() {
+  var self = this;
+  var args = [].slice.call(arguments);
+
+  // n.b. the original callback is always the first form provided
+  var cbIdx = 0;
+  do {
+    if (typeof args[cbIdx] === 'function') {
+      break;
+    }
+    cbIdx++;
+  } while (cbIdx < args.length);
+  var callback = args[cbIdx];
+
+  var extension = function (err, instance) {
+    if (err) {
+      callback(err);
+      return;
+    }
+    if (instance) { // neither undefined nor null
+      ResultSet.extend(instance, self._connection, self._driver);
+    }
+    callback(null, instance);
+  };
+  args[cbIdx] = extension;
+  self._execute.apply(self, args);
+}
+
+var executePromisified = util.promisify(execute);
+
+function close(callback) {
+  var self = this;
+  self._close(function (err) {
+    callback(err);
+  });
+}
+
+var closePromisified = util.promisify(close);
+
+function extend(statement, connection, driver) {
+  Object.defineProperties(
+    statement,
+    {
+      _driver: {
+        value: driver
+      },
+      _connection: {
+        value: connection
+      },
+      _close: {
+        value: statement.close
+      },
+      close: {
+        value: closePromisified,
+        enumerable: true,
+        writable: true
+      },
+      _execute: {
+        value: statement.execute
+      },
+      execute: {
+        value: executePromisified,
+        enumerable: true,
+        writable: true
+      },
+    }
+  );
+}
+
+module.exports.extend = extend;
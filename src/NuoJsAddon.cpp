@@ -7,7 +7,9 @@
 #include "NuoJsNanDate.h"
 #include "NuoJsDriver.h"
 #include "NuoJsConnection.h"
+#include "NuoJsLob.h"
 #include "NuoJsResultSet.h"
+#include "NuoJsStatement.h"
 
 NAN_MODULE_INIT(initModule)
 {
@@ -16,6 +18,8 @@ NAN_MODULE_INIT(initModule)
     NuoJs::Driver::init(target);
     NuoJs::Connection::init(target);
     NuoJs::ResultSet::init(target);
+    NuoJs::Statement::init(target);
+    NuoJs::Lob::init(target);
 }
 
 NODE_MODULE(nuodb, initModule)
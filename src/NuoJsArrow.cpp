@@ -0,0 +1,511 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsArrow.h"
+#include "NuoJsDecimal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace NuoJs
+{
+// The Arrow IPC metadata are flatbuffers, built here by hand for the few
+// tables of the Schema and RecordBatch messages.
+// See: https://arrow.apache.org/docs/format/Columnar.html#serialization-and-interprocess-communication-ipc
+
+// FbObject is a flatbuffer object to be serialized: a table, a string, a
+// vector of tables, or a vector of structs held as their bytes.
+struct FbObject
+{
+    enum Kind { TABLE, STRING, TABLES, STRUCTS };
+    struct Field
+    {
+        uint16_t id;
+        uint8_t size;
+        uint64_t scalar;
+        std::shared_ptr<FbObject> child;
+    };
+
+    explicit FbObject(Kind kind) : kind(kind) {}
+
+    Kind kind;
+    std::vector<Field> fields;
+    std::string bytes;
+    size_t count = 0;
+    std::vector<std::shared_ptr<FbObject>> elements;
+
+    void scalar(uint16_t id, uint8_t size, uint64_t value)
+    {
+        fields.push_back({ id, size, value, nullptr });
+    }
+
+    void child(uint16_t id, std::shared_ptr<FbObject> object)
+    {
+        fields.push_back({ id, 4, 0, object });
+    }
+};
+typedef std::shared_ptr<FbObject> FbRef;
+
+static FbRef fbTable()
+{
+    return std::make_shared<FbObject>(FbObject::TABLE);
+}
+
+static FbRef fbString(const std::string& s)
+{
+    FbRef object = std::make_shared<FbObject>(FbObject::STRING);
+    object->bytes = s;
+    return object;
+}
+
+static FbRef fbTables(std::vector<FbRef> elements)
+{
+    FbRef object = std::make_shared<FbObject>(FbObject::TABLES);
+    object->elements = std::move(elements);
+    return object;
+}
+
+static FbRef fbStructs(std::string bytes, size_t count)
+{
+    FbRef object = std::make_shared<FbObject>(FbObject::STRUCTS);
+    object->bytes = std::move(bytes);
+    object->count = count;
+    return object;
+}
+
+static void putInt(std::string& out, uint64_t value, size_t size)
+{
+    for (size_t index = 0; index < size; index++) {
+        out += (char)(value >> (8 * index));
+    }
+}
+
+static void pad(std::string& out, size_t base, size_t alignment)
+{
+    while ((out.size() - base) % alignment != 0) {
+        out += '\0';
+    }
+}
+
+// FbSerializer lays objects out front to back, each object before the
+// objects it refers to, as flatbuffer offsets only point forward. Tables
+// are preceded by their vtable.
+class FbSerializer
+{
+public:
+    FbSerializer(std::string& out)
+        : out(out), base(out.size())
+    {}
+
+    void serialize(const FbObject& root)
+    {
+        putInt(out, 0, 4);
+        size_t position = write(root);
+        patch(base, position);
+    }
+
+private:
+    std::string& out;
+    size_t base;
+
+    // patch points the offset at position to target
+    void patch(size_t position, size_t target)
+    {
+        uint32_t offset = (uint32_t)(target - position);
+        for (size_t index = 0; index < 4; index++) {
+            out[position + index] = (char)(offset >> (8 * index));
+        }
+    }
+
+    size_t write(const FbObject& object)
+    {
+        switch (object.kind) {
+            case FbObject::TABLE:
+                return writeTable(object);
+
+            case FbObject::STRING: {
+                pad(out, base, 4);
+                size_t position = out.size();
+                putInt(out, object.bytes.size(), 4);
+                out += object.bytes;
+                out += '\0';
+                return position;
+            }
+
+            case FbObject::STRUCTS: {
+                // the structs, after the length, are 8 byte aligned
+                pad(out, base, 4);
+                if ((out.size() - base + 4) % 8 != 0) {
+                    putInt(out, 0, 4);
+                }
+                size_t position = out.size();
+                putInt(out, object.count, 4);
+                out += object.bytes;
+                return position;
+            }
+
+            case FbObject::TABLES: {
+                pad(out, base, 4);
+                size_t position = out.size();
+                putInt(out, object.elements.size(), 4);
+                size_t slots = out.size();
+                out.append(4 * object.elements.size(), '\0');
+                for (size_t index = 0; index < object.elements.size(); index++) {
+                    patch(slots + 4 * index, write(*object.elements[index]));
+                }
+                return position;
+            }
+        }
+        return 0;
+    }
+
+    size_t writeTable(const FbObject& table)
+    {
+        // fields follow the vtable offset, widest first so that each is
+        // aligned to its size
+        std::vector<size_t> order(table.fields.size());
+        for (size_t index = 0; index < order.size(); index++) {
+            order[index] = index;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return table.fields[a].size > table.fields[b].size;
+        });
+        std::vector<size_t> offsets(table.fields.size());
+        size_t size = 4;
+        size_t fieldCount = 0;
+        for (size_t index : order) {
+            const FbObject::Field& field = table.fields[index];
+            size = (size + field.size - 1) / field.size * field.size;
+            offsets[index] = size;
+            size += field.size;
+            fieldCount = std::max(fieldCount, (size_t)field.id + 1);
+        }
+
+        pad(out, base, 2);
+        size_t vtable = out.size();
+        putInt(out, 4 + 2 * fieldCount, 2);
+        putInt(out, size, 2);
+        std::vector<uint16_t> slots(fieldCount, 0);
+        for (size_t index = 0; index < table.fields.size(); index++) {
+            slots[table.fields[index].id] = (uint16_t)offsets[index];
+        }
+        for (uint16_t slot : slots) {
+            putInt(out, slot, 2);
+        }
+
+        pad(out, base, 8);
+        size_t position = out.size();
+        putInt(out, position - vtable, 4);
+        out.append(size - 4, '\0');
+        for (size_t index = 0; index < table.fields.size(); index++) {
+            const FbObject::Field& field = table.fields[index];
+            if (field.child == nullptr) {
+                for (size_t byte = 0; byte < field.size; byte++) {
+                    out[position + offsets[index] + byte] = (char)(field.scalar >> (8 * byte));
+                }
+            }
+        }
+        for (size_t index = 0; index < table.fields.size(); index++) {
+            const FbObject::Field& field = table.fields[index];
+            if (field.child != nullptr) {
+                patch(position + offsets[index], write(*field.child));
+            }
+        }
+        return position;
+    }
+};
+
+// Schema.fbs and Message.fbs constants
+static const uint64_t METADATA_V5 = 4;
+static const uint64_t HEADER_SCHEMA = 1;
+static const uint64_t HEADER_RECORD_BATCH = 3;
+static const uint64_t TYPE_INT = 2;
+static const uint64_t TYPE_FLOATING_POINT = 3;
+static const uint64_t TYPE_BINARY = 4;
+static const uint64_t TYPE_UTF8 = 5;
+static const uint64_t TYPE_BOOL = 6;
+static const uint64_t TYPE_TIMESTAMP = 10;
+static const uint64_t PRECISION_DOUBLE = 2;
+static const uint64_t UNIT_MILLISECOND = 1;
+
+// record batches are also cut short once their values reach this size, to
+// keep string offsets well within 32 bits
+static const size_t MAX_BATCH_BYTES = 64 * 1024 * 1024;
+
+// the size of the reads of a streamed character LOB
+static const size_t LOB_CHUNK_SIZE = 64 * 1024;
+
+static FbRef arrowField(const std::string& name, ArrowColumn::Kind kind)
+{
+    FbRef type = fbTable();
+    uint64_t typeType = TYPE_UTF8;
+    switch (kind) {
+        case ArrowColumn::BOOL:
+            typeType = TYPE_BOOL;
+            break;
+        case ArrowColumn::INT16:
+        case ArrowColumn::INT32:
+        case ArrowColumn::INT64:
+            typeType = TYPE_INT;
+            type->scalar(0, 4, kind == ArrowColumn::INT16 ? 16 : kind == ArrowColumn::INT32 ? 32 : 64);
+            type->scalar(1, 1, 1);
+            break;
+        case ArrowColumn::FLOAT64:
+            typeType = TYPE_FLOATING_POINT;
+            type->scalar(0, 2, PRECISION_DOUBLE);
+            break;
+        case ArrowColumn::TIMESTAMP:
+            typeType = TYPE_TIMESTAMP;
+            type->scalar(0, 2, UNIT_MILLISECOND);
+            type->child(1, fbString("UTC"));
+            break;
+        case ArrowColumn::BINARY:
+            typeType = TYPE_BINARY;
+            break;
+        case ArrowColumn::UTF8:
+            break;
+    }
+    FbRef field = fbTable();
+    field->child(0, fbString(name));
+    field->scalar(1, 1, 1);
+    field->scalar(2, 1, typeType);
+    field->child(3, type);
+    field->child(5, fbTables({}));
+    return field;
+}
+
+// writeMessage appends an encapsulated message: the continuation marker,
+// the size of the metadata, the metadata padded to 8 bytes, and the body.
+static void writeMessage(std::string& out, uint64_t headerType, FbRef header, const std::string& body)
+{
+    FbRef message = fbTable();
+    message->scalar(0, 2, METADATA_V5);
+    message->scalar(1, 1, headerType);
+    message->child(2, header);
+    message->scalar(3, 8, body.size());
+
+    std::string metadata;
+    FbSerializer(metadata).serialize(*message);
+    pad(metadata, 0, 8);
+
+    putInt(out, 0xFFFFFFFF, 4);
+    putInt(out, metadata.size(), 4);
+    out += metadata;
+    out += body;
+}
+
+static inline void appendBit(std::string& bits, size_t index, bool value)
+{
+    if (index % 8 == 0) {
+        bits += '\0';
+    }
+    if (value) {
+        bits.back() |= (char)(1 << (index % 8));
+    }
+}
+
+template<typename T>
+static inline void appendValue(std::string& values, T value)
+{
+    values.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static ArrowColumn::Kind toKind(int sqlType)
+{
+    switch (sqlType) {
+        case NuoDB::NUOSQL_BOOLEAN:
+            return ArrowColumn::BOOL;
+        case NuoDB::NUOSQL_SMALLINT:
+            return ArrowColumn::INT16;
+        case NuoDB::NUOSQL_INTEGER:
+            return ArrowColumn::INT32;
+        case NuoDB::NUOSQL_BIGINT:
+            return ArrowColumn::INT64;
+        case NuoDB::NUOSQL_FLOAT:
+        case NuoDB::NUOSQL_DOUBLE:
+            return ArrowColumn::FLOAT64;
+        case NuoDB::NUOSQL_DATE:
+        case NuoDB::NUOSQL_TIME:
+        case NuoDB::NUOSQL_TIMESTAMP:
+            return ArrowColumn::TIMESTAMP;
+        case NuoDB::NUOSQL_BLOB:
+            return ArrowColumn::BINARY;
+        default:
+            return ArrowColumn::UTF8;
+    }
+}
+
+ArrowWriter::ArrowWriter(Cursor& cursor)
+    : cursor(cursor)
+{
+    for (const Column& column : cursor.getColumns()) {
+        names.push_back(column.name);
+        ArrowColumn arrow;
+        arrow.kind = toKind(column.sqlType);
+        columns.push_back(arrow);
+    }
+    reset();
+}
+
+void ArrowWriter::reset()
+{
+    for (ArrowColumn& column : columns) {
+        column.validity.clear();
+        column.offsets.clear();
+        column.values.clear();
+        column.nulls = 0;
+        if (column.kind == ArrowColumn::UTF8 || column.kind == ArrowColumn::BINARY) {
+            appendValue<int32_t>(column.offsets, 0);
+        }
+    }
+    rows = 0;
+    bytes = 0;
+}
+
+void ArrowWriter::writeHeader(std::string& out)
+{
+    std::vector<FbRef> fields;
+    for (size_t index = 0; index < columns.size(); index++) {
+        fields.push_back(arrowField(names[index], columns[index].kind));
+    }
+    FbRef schema = fbTable();
+    schema->child(1, fbTables(fields));
+    writeMessage(out, HEADER_SCHEMA, schema, std::string());
+}
+
+void ArrowWriter::writeRow(const Cell* row, std::string& out)
+{
+    for (size_t index = 0; index < columns.size(); index++) {
+        appendCell(columns[index], row[index]);
+    }
+    rows++;
+    if (rows >= BATCH_ROWS || bytes >= MAX_BATCH_BYTES) {
+        writeBatch(out);
+    }
+}
+
+void ArrowWriter::writeTrailer(std::string& out)
+{
+    writeBatch(out);
+    // the end of stream marker
+    putInt(out, 0xFFFFFFFF, 4);
+    putInt(out, 0, 4);
+}
+
+void ArrowWriter::appendCell(ArrowColumn& column, const Cell& cell)
+{
+    bool valid = cell.sqlType != NuoDB::NUOSQL_NULL;
+    if (column.kind == ArrowColumn::TIMESTAMP) {
+        // values in an unexpected layout are left null
+        valid = valid && cell.length == 0 && !std::isnan(cell.u.f8);
+    }
+    appendBit(column.validity, rows, valid);
+    if (!valid) {
+        column.nulls++;
+    }
+
+    switch (column.kind) {
+        case ArrowColumn::BOOL:
+            appendBit(column.values, rows, valid && cell.u.b);
+            break;
+        case ArrowColumn::INT16:
+            appendValue<int16_t>(column.values, valid ? cell.u.i16 : 0);
+            break;
+        case ArrowColumn::INT32:
+            appendValue<int32_t>(column.values, valid ? cell.u.i32 : 0);
+            break;
+        case ArrowColumn::INT64:
+            appendValue<int64_t>(column.values, valid ? cell.u.i64 : 0);
+            break;
+        case ArrowColumn::FLOAT64:
+            appendValue<double>(column.values, valid ? cell.u.f8 : 0);
+            break;
+        case ArrowColumn::TIMESTAMP:
+            appendValue<int64_t>(column.values, valid ? (int64_t)cell.u.f8 : 0);
+            break;
+        case ArrowColumn::UTF8:
+        case ArrowColumn::BINARY: {
+            size_t before = column.values.size();
+            if (valid) {
+                appendText(column, cell);
+            }
+            bytes += column.values.size() - before;
+            appendValue<int32_t>(column.offsets, (int32_t)column.values.size());
+            break;
+        }
+    }
+}
+
+// appendText appends the bytes of a variable width value, converting the
+// values of decimal columns to their text.
+void ArrowWriter::appendText(ArrowColumn& column, const Cell& cell)
+{
+    switch (cell.sqlType) {
+        case NuoDB::NUOSQL_DECIMAL:
+            appendDecimal(cell.u.i64, cell.length, column.values);
+            break;
+
+        case NuoDB::NUOSQL_DOUBLE:
+            appendNumber(cell.u.f8, column.values);
+            break;
+
+        case NuoDB::NUOSQL_CLOB:
+            if (cell.length == Cell::STREAMED) {
+                std::vector<char> buffer(LOB_CHUNK_SIZE);
+                size_t offset = 0;
+                bool end = false;
+                while (!end) {
+                    size_t read = cursor.readLob(cell.u.lob, offset, buffer.size(), buffer.data(), end);
+                    column.values.append(buffer.data(), read);
+                    offset += read;
+                }
+                break;
+            }
+            column.values.append(cell.u.s, cell.length);
+            break;
+
+        default:
+            column.values.append(cell.u.s, cell.length);
+            break;
+    }
+}
+
+void ArrowWriter::writeBatch(std::string& out)
+{
+    if (rows == 0) {
+        return;
+    }
+    std::string body;
+    std::string nodes;
+    std::string buffers;
+    size_t bufferCount = 0;
+    auto addBuffer = [&](const std::string& data, size_t length) {
+        putInt(buffers, body.size(), 8);
+        putInt(buffers, length, 8);
+        body.append(data.data(), length);
+        pad(body, 0, 8);
+        bufferCount++;
+    };
+    for (const ArrowColumn& column : columns) {
+        putInt(nodes, rows, 8);
+        putInt(nodes, column.nulls, 8);
+        // the validity bitmap may be left out when there are no nulls
+        addBuffer(column.validity, column.nulls > 0 ? column.validity.size() : 0);
+        if (column.kind == ArrowColumn::UTF8 || column.kind == ArrowColumn::BINARY) {
+            addBuffer(column.offsets, column.offsets.size());
+        }
+        addBuffer(column.values, column.values.size());
+    }
+
+    FbRef batch = fbTable();
+    batch->scalar(0, 8, rows);
+    batch->child(1, fbStructs(nodes, columns.size()));
+    batch->child(2, fbStructs(buffers, bufferCount));
+    writeMessage(out, HEADER_RECORD_BATCH, batch, body);
+    reset();
+}
+} // namespace NuoJs
@@ -0,0 +1,75 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_ARROW_H
+#define NUOJS_ARROW_H
+
+#include "NuoJsCursor.h"
+#include "NuoJsRowBatch.h"
+
+#include <string>
+#include <vector>
+
+namespace NuoJs
+{
+// ArrowColumn accumulates the values of one column of a record batch in the
+// Arrow columnar layout: a validity bitmap, and fixed width values, or int32
+// offsets into the bytes of variable width values.
+struct ArrowColumn
+{
+    enum Kind {
+        BOOL, INT16, INT32, INT64, FLOAT64, TIMESTAMP, UTF8, BINARY
+    };
+    Kind kind = UTF8;
+    std::string validity;
+    std::string offsets;
+    std::string values;
+    size_t nulls = 0;
+};
+
+// ArrowWriter formats fetched rows as an Arrow IPC stream, natively and
+// without V8, so that it runs entirely on a worker thread. Each column is
+// built contiguously, straight from the cells of the rows, and written as
+// record batches of up to BATCH_ROWS rows.
+//
+// Integers, doubles and booleans keep their type; dates, times and time
+// stamps are UTC millisecond timestamps; binary values are Binary; and all
+// other values, decimals included, are UTF-8 strings. Streamed character
+// LOBs are read to the end through the cursor.
+class ArrowWriter
+{
+public:
+    static const size_t BATCH_ROWS = 64 * 1024;
+
+    // The cursor must have returned its first fetch, which describes the
+    // columns.
+    explicit ArrowWriter(Cursor& cursor);
+
+    // writeHeader appends the schema message to out.
+    void writeHeader(std::string& out);
+
+    // writeRow adds one row of cells to the current record batch, appending
+    // the batch to out once it is full.
+    void writeRow(const Cell* row, std::string& out);
+
+    // writeTrailer appends the last record batch and the end of stream
+    // marker to out.
+    void writeTrailer(std::string& out);
+
+private:
+    Cursor& cursor;
+    std::vector<std::string> names;
+    std::vector<ArrowColumn> columns;
+    size_t rows = 0;
+    size_t bytes = 0;
+
+    void reset();
+    void writeBatch(std::string& out);
+    void appendCell(ArrowColumn& column, const Cell& cell);
+    void appendText(ArrowColumn& column, const Cell& cell);
+};
+} // namespace NuoJs
+
+#endif
@@ -0,0 +1,293 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsBinds.h"
+#include "NuoJsNan.h"
+#include "NuoJsTypes.h"
+#include "NuoJsErrMsg.h"
+#include "NuoJsDateCodec.h"
+
+#include <cstring>
+
+namespace NuoJs
+{
+void getJsBinds(Local<Array> array, Binds& binds)
+{
+    Nan::HandleScope scope;
+    Isolate* isolate = Isolate::GetCurrent();
+    Local<Context> ctx = isolate->GetCurrentContext();
+
+    binds.resize(array->Length());
+    for (size_t index = 0; index < binds.size(); index++) {
+        Local<Value> value = array->Get(ctx, index).ToLocalChecked();
+        SqlValue& bind = binds[index];
+
+        // Buffers, and any other view of binary data, are sent as bytes.
+        if (value->IsArrayBufferView()) {
+            Local<ArrayBufferView> view = value.As<ArrayBufferView>();
+            std::string bytes(view->ByteLength(), '\0');
+            view->CopyContents(&bytes[0], bytes.size());
+            bind.setSqlType(NuoDB::NUOSQL_BLOB);
+            bind.setString(std::move(bytes));
+            continue;
+        }
+
+        // The top-level case statements below correspond to the five
+        // fundamental data types in ES. Within these types we need to
+        // check if it will result in a safe conversion (e.g. Number).
+        switch (Type::fromEsType(typeOf(value))) {
+            case NuoDB::NUOSQL_UNDEFINED:
+            case NuoDB::SqlType::NUOSQL_NULL:
+                bind.setSqlType(NuoDB::NUOSQL_NULL);
+                break;
+
+            case NuoDB::SqlType::NUOSQL_BOOLEAN:
+                bind.setSqlType(NuoDB::NUOSQL_BOOLEAN);
+                bind.setBoolean(toBool(value));
+                break;
+
+            case NuoDB::SqlType::NUOSQL_DOUBLE:
+                // If the value can be safely coerced to a sized integer
+                // or float without loss of precision, send a numeric
+                // value rather than a string. If we're dealing with
+                // a number that is larger than can be safely coerced,
+                // convert it to a string.
+                if (isInt16(value)) {
+                    bind.setSqlType(NuoDB::NUOSQL_SMALLINT);
+                    bind.setShort(toInt16(value));
+                } else if (isInt32(value)) {
+                    bind.setSqlType(NuoDB::NUOSQL_INTEGER);
+                    bind.setInt(toInt32(value));
+                } else if (isFloat(value)) {
+                    bind.setSqlType(NuoDB::NUOSQL_FLOAT);
+                    bind.setFloat(toFloat(value));
+                } else {
+                    bind.setSqlType(NuoDB::NUOSQL_DOUBLE);
+                    bind.setDouble(toDouble(value));
+                }
+                break;
+
+            case NuoDB::NUOSQL_BIGINT: {
+                // A BigInt outside the range of a 64-bit integer is sent
+                // as a string, in the same way as an unsafe number.
+                bool lossless = false;
+                int64_t v = value.As<BigInt>()->Int64Value(&lossless);
+                if (lossless) {
+                    bind.setSqlType(NuoDB::NUOSQL_BIGINT);
+                    bind.setLong(v);
+                } else {
+                    Nan::Utf8String string(value);
+                    bind.setSqlType(NuoDB::NUOSQL_VARCHAR);
+                    bind.setString(std::string(*string, string.length()));
+                }
+                break;
+            }
+
+            case NuoDB::NUOSQL_DATE:
+                // milliseconds since the epoch, formatted when bound
+                bind.setSqlType(NuoDB::NUOSQL_DATE);
+                bind.setLong(toInt64(value));
+                break;
+
+            case NuoDB::SqlType::NUOSQL_VARCHAR:
+            default:
+                bind.setSqlType(NuoDB::NUOSQL_VARCHAR);
+                bind.setString(toString(value));
+                break;
+        }
+    }
+}
+
+void bindStatement(NuoDB::PreparedStatement* statement, const Binds& binds)
+{
+    for (size_t index = 0; index < binds.size(); index++) {
+        const SqlValue& bind = binds[index];
+        int sqlIdx = index + 1;
+
+        switch (bind.getSqlType()) {
+            case NuoDB::NUOSQL_NULL:
+                statement->setNull(sqlIdx, NuoDB::NUOSQL_NULL);
+                break;
+
+            case NuoDB::NUOSQL_BOOLEAN:
+                statement->setBoolean(sqlIdx, bind.getBoolean());
+                break;
+
+            case NuoDB::NUOSQL_SMALLINT:
+                statement->setShort(sqlIdx, bind.getShort());
+                break;
+
+            case NuoDB::NUOSQL_INTEGER:
+                statement->setInt(sqlIdx, bind.getInt());
+                break;
+
+            case NuoDB::NUOSQL_FLOAT:
+                statement->setFloat(sqlIdx, bind.getFloat());
+                break;
+
+            case NuoDB::NUOSQL_DOUBLE:
+                statement->setDouble(sqlIdx, bind.getDouble());
+                break;
+
+            case NuoDB::NUOSQL_BIGINT:
+                statement->setLong(sqlIdx, bind.getLong());
+                break;
+
+            case NuoDB::NUOSQL_BLOB: {
+                const std::string& bytes = bind.getString();
+                statement->setBytes(sqlIdx, (int)bytes.size(), bytes.data());
+                break;
+            }
+
+            case NuoDB::NUOSQL_DATE: {
+                char buffer[80];
+                formatTimestamp(bind.getLong(), buffer, sizeof(buffer));
+                statement->setString(sqlIdx, buffer);
+                break;
+            }
+
+            default:
+                statement->setString(sqlIdx, bind.getString().c_str());
+                break;
+        }
+    }
+}
+
+// getTypedColumn references the backing store of a typed array column,
+// returning false when the value is not a supported typed array.
+static bool getTypedColumn(Local<Value> value, BindColumn& column)
+{
+    if (value->IsInt8Array()) {
+        column.kind = BindColumn::INT8;
+    } else if (value->IsUint8Array() || value->IsUint8ClampedArray()) {
+        column.kind = BindColumn::UINT8;
+    } else if (value->IsInt16Array()) {
+        column.kind = BindColumn::INT16;
+    } else if (value->IsUint16Array()) {
+        column.kind = BindColumn::UINT16;
+    } else if (value->IsInt32Array()) {
+        column.kind = BindColumn::INT32;
+    } else if (value->IsUint32Array()) {
+        column.kind = BindColumn::UINT32;
+    } else if (value->IsFloat32Array()) {
+        column.kind = BindColumn::FLOAT32;
+    } else if (value->IsFloat64Array()) {
+        column.kind = BindColumn::FLOAT64;
+    } else if (value->IsBigInt64Array()) {
+        column.kind = BindColumn::BIGINT64;
+    } else {
+        return false;
+    }
+    Local<TypedArray> typed = value.As<TypedArray>();
+    column.length = typed->Length();
+    column.store = typed->Buffer()->GetBackingStore();
+    column.data = static_cast<const uint8_t*>(column.store->Data()) + typed->ByteOffset();
+    return true;
+}
+
+size_t getJsBindColumns(Local<Array> array, BindColumns& columns)
+{
+    Nan::HandleScope scope;
+    Isolate* isolate = Isolate::GetCurrent();
+    Local<Context> ctx = isolate->GetCurrentContext();
+
+    columns.resize(array->Length());
+    for (size_t index = 0; index < columns.size(); index++) {
+        Local<Value> value = array->Get(ctx, index).ToLocalChecked();
+        BindColumn& column = columns[index];
+
+        if (getTypedColumn(value, column)) {
+            // bound directly from the backing store
+        } else if (value->IsArray()) {
+            Local<Array> cells = value.As<Array>();
+            column.kind = BindColumn::STRINGS;
+            column.length = cells->Length();
+            column.strings.resize(column.length);
+            column.nulls.resize(column.length);
+            for (size_t row = 0; row < column.length; row++) {
+                Local<Value> cell = cells->Get(ctx, row).ToLocalChecked();
+                if (cell->IsNullOrUndefined()) {
+                    column.nulls[row] = true;
+                } else {
+                    Nan::Utf8String string(cell);
+                    column.strings[row].assign(*string, string.length());
+                }
+            }
+        } else {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidParamValue, (int)index);
+            throw std::runtime_error(message);
+        }
+
+        if (column.length != columns[0].length) {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidParamValue, (int)index);
+            throw std::runtime_error(message);
+        }
+    }
+    return columns.empty() ? 0 : columns[0].length;
+}
+
+template<typename T>
+static T getCell(const BindColumn& column, size_t row)
+{
+    // typed arrays need not be aligned within their buffer
+    T value;
+    memcpy(&value, column.data + row * sizeof(T), sizeof(T));
+    return value;
+}
+
+void bindStatementRow(NuoDB::PreparedStatement* statement, const BindColumns& columns, size_t row)
+{
+    for (size_t index = 0; index < columns.size(); index++) {
+        const BindColumn& column = columns[index];
+        int sqlIdx = index + 1;
+
+        switch (column.kind) {
+            case BindColumn::INT8:
+                statement->setShort(sqlIdx, getCell<int8_t>(column, row));
+                break;
+
+            case BindColumn::UINT8:
+                statement->setShort(sqlIdx, getCell<uint8_t>(column, row));
+                break;
+
+            case BindColumn::INT16:
+                statement->setShort(sqlIdx, getCell<int16_t>(column, row));
+                break;
+
+            case BindColumn::UINT16:
+                statement->setInt(sqlIdx, getCell<uint16_t>(column, row));
+                break;
+
+            case BindColumn::INT32:
+                statement->setInt(sqlIdx, getCell<int32_t>(column, row));
+                break;
+
+            case BindColumn::UINT32:
+                statement->setLong(sqlIdx, getCell<uint32_t>(column, row));
+                break;
+
+            case BindColumn::FLOAT32:
+                statement->setFloat(sqlIdx, getCell<float>(column, row));
+                break;
+
+            case BindColumn::FLOAT64:
+                statement->setDouble(sqlIdx, getCell<double>(column, row));
+                break;
+
+            case BindColumn::BIGINT64:
+                statement->setLong(sqlIdx, getCell<int64_t>(column, row));
+                break;
+
+            case BindColumn::STRINGS:
+                if (column.nulls[row]) {
+                    statement->setNull(sqlIdx, NuoDB::NUOSQL_NULL);
+                } else {
+                    statement->setString(sqlIdx, column.strings[row].c_str());
+                }
+                break;
+        }
+    }
+}
+}
@@ -0,0 +1,59 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_BINDS_H
+#define NUOJS_BINDS_H
+
+#include "NuoJsAddon.h"
+#include "NuoJsValue.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NuoJs
+{
+// Binds holds the parameters of a statement execution as plain native
+// values, so that the statement can be bound on a worker thread.
+typedef std::vector<SqlValue> Binds;
+
+// getJsBinds converts ES bind values into native values. It reads V8 values
+// and so must be called on the main event loop thread.
+void getJsBinds(Local<Array> array, Binds& binds);
+
+// bindStatement sets the parameters of a prepared statement from native
+// values. It does not touch V8 and is safe to call on a worker thread.
+void bindStatement(NuoDB::PreparedStatement* statement, const Binds& binds);
+
+// BindColumn holds the values of one parameter for many rows. Typed array
+// columns reference the typed array backing store, which the column keeps
+// alive, and are read directly on the worker thread. Any other array is
+// captured as strings, with null and undefined becoming NULL.
+struct BindColumn
+{
+    enum Kind {
+        INT8, UINT8, INT16, UINT16, INT32, UINT32,
+        FLOAT32, FLOAT64, BIGINT64, STRINGS
+    };
+    Kind kind = STRINGS;
+    size_t length = 0;
+    std::shared_ptr<BackingStore> store;
+    const uint8_t* data = nullptr;
+    std::vector<std::string> strings;
+    std::vector<bool> nulls;
+};
+typedef std::vector<BindColumn> BindColumns;
+
+// getJsBindColumns captures an array of column arrays, returning the number
+// of rows. All columns must have the same length. It reads V8 values and so
+// must be called on the main event loop thread.
+size_t getJsBindColumns(Local<Array> array, BindColumns& columns);
+
+// bindStatementRow sets the parameters of a prepared statement from one row
+// of the columns. It does not touch V8 and is safe to call on a worker thread.
+void bindStatementRow(NuoDB::PreparedStatement* statement, const BindColumns& columns, size_t row);
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsColumnar.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace NuoJs
+{
+static TypedColumn::Kind toKind(int sqlType, DecimalMode decimalMode)
+{
+    switch (sqlType) {
+        case NuoDB::NUOSQL_SMALLINT:
+        case NuoDB::NUOSQL_INTEGER:
+            return TypedColumn::INT32;
+        case NuoDB::NUOSQL_BIGINT:
+            return TypedColumn::BIGINT64;
+        case NuoDB::NUOSQL_FLOAT:
+        case NuoDB::NUOSQL_DOUBLE:
+            return TypedColumn::FLOAT64;
+        case NuoDB::NUOSQL_DECIMAL:
+            return decimalMode == DECIMALS_AS_NUMBER ? TypedColumn::FLOAT64 : TypedColumn::VALUES;
+        default:
+            return TypedColumn::VALUES;
+    }
+}
+
+// toDouble converts the value of a floating point column.
+static double toDouble(const Cell& cell)
+{
+    switch (cell.sqlType) {
+        case NuoDB::NUOSQL_SMALLINT:
+            return cell.u.i16;
+        case NuoDB::NUOSQL_INTEGER:
+            return cell.u.i32;
+        case NuoDB::NUOSQL_BIGINT:
+            return (double)cell.u.i64;
+        default:
+            return cell.u.f8;
+    }
+}
+
+static char* allocate(size_t size)
+{
+    // malloc(0) may return null, which Buffers do not take
+    char* memory = static_cast<char*>(malloc(size > 0 ? size : 1));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+size_t TypedColumn::getElementSize() const
+{
+    switch (kind) {
+        case INT32:
+            return sizeof(int32_t);
+        case FLOAT64:
+            return sizeof(double);
+        case BIGINT64:
+            return sizeof(int64_t);
+        default:
+            return 0;
+    }
+}
+
+ColumnarRows::ColumnarRows(RowBatches batches, const Columns& columns, DecimalMode decimalMode)
+    : batches(std::move(batches))
+{
+    for (const RowBatch& batch : this->batches) {
+        rows += batch.size();
+    }
+    this->columns.resize(columns.size());
+    for (size_t colIdx = 0; colIdx < columns.size(); colIdx++) {
+        TypedColumn& column = this->columns[colIdx];
+        column.kind = toKind(columns[colIdx].sqlType, decimalMode);
+        if (columns[colIdx].sqlType == NuoDB::NUOSQL_DECIMAL && hasText(colIdx)) {
+            // a decimal that did not survive the conversion to a Number was
+            // kept as its text, which the column returns as getRows would
+            column.kind = TypedColumn::VALUES;
+        }
+        if (column.kind != TypedColumn::VALUES) {
+            fill(column, colIdx);
+        }
+    }
+}
+
+ColumnarRows::~ColumnarRows()
+{
+    for (TypedColumn& column : columns) {
+        free(column.values);
+        free(column.nulls);
+    }
+}
+
+bool ColumnarRows::hasText(size_t colIdx) const
+{
+    for (const RowBatch& batch : batches) {
+        for (size_t batchIdx = 0; batchIdx < batch.size(); batchIdx++) {
+            if (batch.getRow(batchIdx)[colIdx].sqlType == NuoDB::NUOSQL_VARCHAR) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ColumnarRows::fill(TypedColumn& column, size_t colIdx)
+{
+    column.values = allocate(rows * column.getElementSize());
+    size_t rowIdx = 0;
+    for (const RowBatch& batch : batches) {
+        for (size_t batchIdx = 0; batchIdx < batch.size(); batchIdx++, rowIdx++) {
+            const Cell& cell = batch.getRow(batchIdx)[colIdx];
+            bool isNull = cell.sqlType == NuoDB::NUOSQL_NULL;
+            if (isNull) {
+                if (column.nulls == nullptr) {
+                    column.nulls = allocate((rows + 7) / 8);
+                    memset(column.nulls, 0, (rows + 7) / 8);
+                }
+                column.nulls[rowIdx / 8] |= (char)(1 << (rowIdx % 8));
+            }
+            switch (column.kind) {
+                case TypedColumn::INT32:
+                    reinterpret_cast<int32_t*>(column.values)[rowIdx] =
+                        isNull ? 0 : cell.sqlType == NuoDB::NUOSQL_SMALLINT ? cell.u.i16 : cell.u.i32;
+                    break;
+                case TypedColumn::BIGINT64:
+                    reinterpret_cast<int64_t*>(column.values)[rowIdx] = isNull ? 0 : cell.u.i64;
+                    break;
+                case TypedColumn::FLOAT64:
+                    reinterpret_cast<double*>(column.values)[rowIdx] = isNull ? 0 : toDouble(cell);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+size_t ColumnarRows::size() const
+{
+    return rows;
+}
+
+size_t ColumnarRows::getWidth() const
+{
+    return columns.size();
+}
+
+RowBatches& ColumnarRows::getBatches()
+{
+    return batches;
+}
+
+TypedColumn& ColumnarRows::getColumn(size_t column)
+{
+    return columns[column];
+}
+} // namespace NuoJs
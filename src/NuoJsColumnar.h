@@ -0,0 +1,71 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_COLUMNAR_H
+#define NUOJS_COLUMNAR_H
+
+#include "NuoJsCursor.h"
+#include "NuoJsDecimalMode.h"
+#include "NuoJsRowBatch.h"
+
+#include <vector>
+
+namespace NuoJs
+{
+// TypedColumn holds the values of a numeric column laid out as the elements
+// of a typed array, and a bitmap of its nulls, one bit per row from the low
+// bit of the first byte, allocated on the first null. A null is 0 in the
+// values. Both are malloc'd, to be handed to ES without copying.
+struct TypedColumn
+{
+    enum Kind {
+        VALUES, // not numeric, returned as an Array
+        INT32,
+        FLOAT64,
+        BIGINT64
+    };
+    Kind kind = VALUES;
+    char* values = nullptr;
+    char* nulls = nullptr;
+
+    size_t getElementSize() const;
+};
+
+// ColumnarRows transposes rows taken from a cursor into columns. The
+// numeric columns are filled natively, so that this can run on a worker
+// thread: SMALLINT and INTEGER columns as Int32Array elements, BIGINT
+// columns as BigInt64Array elements, and floating point columns, and
+// decimals returned as numbers, as Float64Array elements, unless one of
+// them was kept as text because no Number holds it exactly. The batches are
+// kept for the values of the other columns, which become JS values on the
+// main thread.
+class ColumnarRows
+{
+public:
+    ColumnarRows(RowBatches batches, const Columns& columns, DecimalMode decimalMode);
+    ~ColumnarRows();
+
+    ColumnarRows(const ColumnarRows&) = delete;
+    ColumnarRows& operator=(const ColumnarRows&) = delete;
+
+    size_t size() const;
+    size_t getWidth() const;
+    RowBatches& getBatches();
+
+    // getColumn returns a column, whose values and nulls may be taken by
+    // the caller, who must then free them and set them to null.
+    TypedColumn& getColumn(size_t column);
+
+private:
+    RowBatches batches;
+    std::vector<TypedColumn> columns;
+    size_t rows = 0;
+
+    bool hasText(size_t colIdx) const;
+    void fill(TypedColumn& column, size_t colIdx);
+};
+} // namespace NuoJs
+
+#endif
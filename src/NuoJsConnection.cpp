@@ -9,6 +9,9 @@
 #include "NuoJsTypes.h"
 #include "NuoJsNan.h"
 #include "NuoJsResultSet.h"
+#include "NuoJsStatement.h"
+#include "NuoJsRowReader.h"
+#include "NuoJsJson.h"
 #include <iostream>
 #include <thread>
 #include <sstream>
@@ -18,6 +21,12 @@
 #include <string>
 #include <mutex>
 #include <vector>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "NuoDB.h"
 
@@ -113,8 +122,24 @@ unsigned int Connection::Restricted_API(const std::string& s)
   return retvalue;
 }
 
+// parseSetting parses the value of a numeric environment variable, a
+// decimal of at most max with no sign or other characters.
+static bool parseSetting(const char* setting, uint64_t max, uint64_t& value)
+{
+    if (!isdigit((unsigned char)setting[0])) {
+        return false;
+    }
+    try {
+        size_t used = 0;
+        value = std::stoull(std::string(setting), &used);
+        return setting[used] == '\0' && value <= max;
+    } catch (std::exception& e) {
+        return false;
+    }
+}
+
 Connection::Connection()
-    : Nan::ObjectWrap()
+    : Nan::ObjectWrap(), statementCache(std::make_shared<StatementCache>(StatementCache::Default_Capacity))
 {
     TRACE("Connection::Connection");
     _AutoCommit = Default_AutoCommit;
@@ -143,6 +168,10 @@ NAN_MODULE_INIT(Connection::init)
     Nan::SetPrototypeMethod(tpl, "close", close);
     Nan::SetPrototypeMethod(tpl, "commit", commit);
     Nan::SetPrototypeMethod(tpl, "execute", execute),
+    Nan::SetPrototypeMethod(tpl, "executeBatch", executeBatch);
+    Nan::SetPrototypeMethod(tpl, "executeColumns", executeColumns);
+    Nan::SetPrototypeMethod(tpl, "loadFrom", loadFrom);
+    Nan::SetPrototypeMethod(tpl, "prepare", prepare);
     Nan::SetPrototypeMethod(tpl, "rollback", rollback);
     Nan::SetPrototypeMethod(tpl, "hasFailed", hasFailed);
 
@@ -161,6 +190,43 @@ NAN_MODULE_INIT(Connection::init)
     if (restrictedAPISetting != NULL) {
       setRestrictedAPI(Restricted_API(std::string(restrictedAPISetting)));
     }
+
+    // The number of idle prepared statements each connection keeps for reuse,
+    // zero disables the statement cache
+    char* statementCacheSetting = getenv("NUODB_NODE_STATEMENT_CACHE_SIZE");
+    if (statementCacheSetting != NULL) {
+      uint64_t value = 0;
+      if (!parseSetting(statementCacheSetting, UINT32_MAX, value)) {
+        std::string message = ErrMsg::get(ErrMsgType::errBadConfiguration, "Invalid Statement Cache Size");
+        Nan::ThrowError(message.c_str());
+        return;
+      }
+      StatementCache::Default_Capacity = (uint32_t)value;
+    }
+
+    // Driver-wide defaults of the maxRows and maxBufferedBytes query options,
+    // so that an unbounded query cannot exhaust the memory of the process
+    char* maxRowsSetting = getenv("NUODB_NODE_MAX_ROWS");
+    if (maxRowsSetting != NULL) {
+      // the database takes the limit as an int
+      uint64_t value = 0;
+      if (!parseSetting(maxRowsSetting, INT32_MAX, value)) {
+        std::string message = ErrMsg::get(ErrMsgType::errBadConfiguration, "Invalid Max Rows");
+        Nan::ThrowError(message.c_str());
+        return;
+      }
+      Options::Default_MaxRows = (uint32_t)value;
+    }
+    char* maxBufferedBytesSetting = getenv("NUODB_NODE_MAX_BUFFERED_BYTES");
+    if (maxBufferedBytesSetting != NULL) {
+      uint64_t value = 0;
+      if (!parseSetting(maxBufferedBytesSetting, UINT64_MAX, value)) {
+        std::string message = ErrMsg::get(ErrMsgType::errBadConfiguration, "Invalid Max Buffered Bytes");
+        Nan::ThrowError(message.c_str());
+        return;
+      }
+      Options::Default_MaxBufferedBytes = value;
+    }
 }
 
 unsigned int Connection::getRestrictedAPI() {
@@ -277,6 +343,7 @@ void Connection::doClose()
     }
 
     try {
+        statementCache->close();
         connection->close();
         connection = nullptr;
     } catch (NuoDB::SQLException& e) {
@@ -458,8 +525,8 @@ class ExecuteWorker : public Nan::AsyncWorker
   public:
     std::string _sql;
 
-    ExecuteWorker(Nan::Callback* callback, Connection* self, NuoDB::PreparedStatement* statement, Options options, const char* error, std::string sql)
-        : Nan::AsyncWorker(callback), self(self), statement(statement), options(options), error(error), hasResults(false)
+    ExecuteWorker(Nan::Callback* callback, Connection* self, Binds binds, Options options, std::string error, std::string sql)
+        : Nan::AsyncWorker(callback), self(self), binds(binds), options(options), error(error), hasResults(false)
     {
         TRACE("ExecuteWorker::ExecuteWorker");
         data = manager.getData();
@@ -476,16 +543,25 @@ class ExecuteWorker : public Nan::AsyncWorker
     virtual void Execute()
     {
         TRACE("ExecuteWorker::~Execute");
-        if (error) {
-            SetErrorMessage(error);
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
             SUBTRACT_COUNT(EXECUTE_QUE, QUE, data)
             return;
         }
         try {
           ADD_COUNT(EXECUTE_DO, DO, data)
           SUBTRACT_COUNT(EXECUTE_DO, DO, data)
+          statement = self->createStatement(this->_sql, binds, options.getQueryTimeout(), options.getMaxRows());
           hasResults = self->doExecute(statement,this->_sql);
+          // the first rows are returned along with the result set, so
+          // small queries complete without another trip to a worker
+          if (hasResults && options.getFetchSize() > 0) {
+              cursor = Cursor::open(statement, options.getFetchSize(), options);
+          }
         } catch (std::exception& e) {
+            cursor.reset();
+            self->statementCache->discard(statement);
+            statement = nullptr;
             SetErrorMessage(e.what());
             SUBTRACT_COUNT(EXECUTE_QUE, QUE, data)
         }
@@ -497,9 +573,9 @@ class ExecuteWorker : public Nan::AsyncWorker
         Nan::HandleScope scope;
         Local<Value> results = Nan::Undefined();
         if (hasResults) {
-            results = ResultSet::createFrom(statement, options);
+            results = ResultSet::createFrom(statement, options, self->statementCache, _sql, std::move(cursor));
         } else {
-            statement->close();
+            self->statementCache->release(_sql, statement);
         }
         Local<Value> argv[] = {
             Nan::Null(),
@@ -514,9 +590,11 @@ class ExecuteWorker : public Nan::AsyncWorker
   protected:
     NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
     Connection* self;
-    NuoDB::PreparedStatement* statement;
+    NuoDB::PreparedStatement* statement = nullptr;
+    std::unique_ptr<Cursor> cursor;
+    Binds binds;
     Options options;
-    const char* error;
+    std::string error;
     bool hasResults;
 };
 
@@ -525,7 +603,7 @@ NAN_METHOD(Connection::execute)
 {
     TRACE("Connection::execute");
     Nan::HandleScope scope;
-    const char* error = nullptr;
+    std::string error;
 
     Connection* self = Nan::ObjectWrap::Unwrap<Connection>(info.This());
 
@@ -544,11 +622,17 @@ NAN_METHOD(Connection::execute)
     std::string sql(*sqlString);
 
     // binds (optional), track the index if they are present...
+    // The values are only captured here, the statement is prepared and
+    // bound by the worker so that neither blocks the event loop.
     auto infoIdx = 1;
     auto infoLen = info.Length();
-    Local<Array> binds = Nan::New<Array>(0);
+    Binds binds;
     if (infoLen > 1 && info[infoIdx]->IsArray()) {
-        binds = info[infoIdx++].As<Array>();
+        try {
+            getJsBinds(info[infoIdx++].As<Array>(), binds);
+        } catch (std::exception& e) {
+            error = e.what();
+        }
     }
 
     // query options (optional) that can be specified by the user
@@ -572,118 +656,753 @@ NAN_METHOD(Connection::execute)
           }
       }
     TRACE("Connection::execute:set");
-      if ((options.isNonDefault(Options::Option::isolationlevel)) && (self->_IsolationLevel != options.getIsolationLevel())) self->setIsolationLevel(options.getIsolationLevel());
-      if ((options.isNonDefault(Options::Option::autocommit)) && (self->_AutoCommit != options.getAutoCommit())) self->setAutoCommit(options.getAutoCommit());
-      if ((options.isNonDefault(Options::Option::readonly)) && (self->_ReadOnly != options.getReadOnly())) self->setReadOnly(options.getReadOnly());
+      self->applyOptions(options);
     } catch (std::exception& e) {
         error = e.what();
     }
 
-    TRACE("Connection::execute:prepare");
-    NuoDB::PreparedStatement* statement = nullptr;
+    Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
+
+    ExecuteWorker* worker = new ExecuteWorker(callback, self, binds, options, error, sql);
+    worker->SaveToPersistent("nuodb:Connection", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(EXECUTE_QUE, QUE, worker->data)
+}
+
+void Connection::applyOptions(Options& options)
+{
+    if ((options.isNonDefault(Options::Option::isolationlevel)) && (_IsolationLevel != options.getIsolationLevel())) setIsolationLevel(options.getIsolationLevel());
+    if ((options.isNonDefault(Options::Option::autocommit)) && (_AutoCommit != options.getAutoCommit())) setAutoCommit(options.getAutoCommit());
+    if ((options.isNonDefault(Options::Option::readonly)) && (_ReadOnly != options.getReadOnly())) setReadOnly(options.getReadOnly());
+}
+
+class ExecuteBatchWorker : public Nan::AsyncWorker
+{
+  public:
+    ExecuteBatchWorker(Nan::Callback* callback, Connection* self, std::vector<Binds> rows, Options options, std::string error, std::string sql)
+        : Nan::AsyncWorker(callback), self(self), rows(std::move(rows)), options(options), error(error), sql(sql)
+    {
+        TRACE("ExecuteBatchWorker::ExecuteBatchWorker");
+        data = manager.getData();
+        COUNT_ADD(data, EXECUTEBATCH_CNT);
+    }
+
+    virtual ~ExecuteBatchWorker()
+    {
+        TRACE("ExecuteBatchWorker::~ExecuteBatchWorker");
+        COUNT_SUB(data, EXECUTEBATCH_CNT);
+    }
+
+    virtual void Execute()
+    {
+        TRACE("ExecuteBatchWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(EXECUTEBATCH_QUE, QUE, data)
+            return;
+        }
+        if (rows.empty()) {
+            return;
+        }
+        NuoDB::PreparedStatement* statement = nullptr;
+        try {
+          ADD_COUNT(EXECUTEBATCH_DO, DO, data)
+          SUBTRACT_COUNT(EXECUTEBATCH_DO, DO, data)
+          statement = self->createStatement(sql, Binds(), options.getQueryTimeout());
+          self->doExecuteBatch(statement, rows, counts);
+          self->statementCache->release(sql, statement);
+        } catch (std::exception& e) {
+            self->statementCache->discard(statement);
+            SetErrorMessage(e.what());
+            SUBTRACT_COUNT(EXECUTEBATCH_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("ExecuteBatchWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Array> results = Nan::New<Array>((int)counts.size());
+        for (size_t index = 0; index < counts.size(); index++) {
+            Nan::Set(results, (uint32_t)index, Nan::New<Number>(counts[index]));
+        }
+        Local<Value> argv[] = {
+            Nan::Null(),
+            results
+        };
+        SUBTRACT_COUNT(EXECUTEBATCH_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+  protected:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    Connection* self;
+    std::vector<Binds> rows;
+    Options options;
+    std::string error;
+    std::string sql;
+    std::vector<int> counts;
+};
+
+/* static */
+NAN_METHOD(Connection::executeBatch)
+{
+    TRACE("Connection::executeBatch");
+    Nan::HandleScope scope;
+    std::string error;
+
+    Connection* self = Nan::ObjectWrap::Unwrap<Connection>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    // first parameter is always a SQL DML string
+    if (!info[0]->IsString()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 0);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    Nan::Utf8String sqlString(info[0].As<String>());
+    std::string sql(*sqlString);
+
+    // second parameter is an array holding the binds of each row
+    if (info.Length() < 3 || !info[1]->IsArray()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 1);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    Local<Array> array = info[1].As<Array>();
+    Local<Context> ctx = Isolate::GetCurrent()->GetCurrentContext();
+    std::vector<Binds> rows(array->Length());
+    for (size_t index = 0; index < rows.size(); index++) {
+        Local<Value> row = array->Get(ctx, index).ToLocalChecked();
+        if (!row->IsArray()) {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidParamValue, 1);
+            Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+            return;
+        }
+        try {
+            getJsBinds(row.As<Array>(), rows[index]);
+        } catch (std::exception& e) {
+            error = e.what();
+            break;
+        }
+    }
+
+    // query options (optional) that can be specified by the user
+    auto infoIdx = 2;
+    Options options;
+    if (info.Length() > infoIdx && !info[infoIdx]->IsFunction()) {
+        try {
+            getJsonOptions(info[infoIdx++].As<Object>(), options);
+        } catch (std::exception& e) {
+            Nan::ThrowError(e.what());
+            return;
+        }
+    }
+    try {
+        self->applyOptions(options);
+    } catch (std::exception& e) {
+        error = e.what();
+    }
+
+    Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
+
+    ExecuteBatchWorker* worker = new ExecuteBatchWorker(callback, self, std::move(rows), options, error, sql);
+    worker->SaveToPersistent("nuodb:Connection", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(EXECUTEBATCH_QUE, QUE, worker->data)
+}
+
+// doExecuteBatch binds every row and sends them to the database in a single
+// batch, returning the update count of each row. It runs on a worker thread
+// and must not touch V8.
+void Connection::doExecuteBatch(NuoDB::PreparedStatement* statement, const std::vector<Binds>& rows, std::vector<int>& counts)
+{
+    try {
+        for (const Binds& binds : rows) {
+            bindStatement(statement, binds);
+            statement->addBatch();
+        }
+        const int* results = statement->executeBatch();
+        counts.assign(results, results + rows.size());
+    } catch (NuoDB::SQLException& e) {
+        // Execution has failed, see if the failure should consider the connection dead
+        markForFailure(e);
+        throw std::runtime_error(ErrMsg::get(e));
+    }
+}
+
+class ExecuteColumnsWorker : public Nan::AsyncWorker
+{
+  public:
+    ExecuteColumnsWorker(Nan::Callback* callback, Connection* self, BindColumns columns, size_t rows, Options options, std::string error, std::string sql)
+        : Nan::AsyncWorker(callback), self(self), columns(std::move(columns)), rows(rows), options(options), error(error), sql(sql)
+    {
+        TRACE("ExecuteColumnsWorker::ExecuteColumnsWorker");
+        data = manager.getData();
+        COUNT_ADD(data, EXECUTEBATCH_CNT);
+    }
+
+    virtual ~ExecuteColumnsWorker()
+    {
+        TRACE("ExecuteColumnsWorker::~ExecuteColumnsWorker");
+        COUNT_SUB(data, EXECUTEBATCH_CNT);
+    }
+
+    virtual void Execute()
+    {
+        TRACE("ExecuteColumnsWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(EXECUTEBATCH_QUE, QUE, data)
+            return;
+        }
+        if (rows == 0) {
+            return;
+        }
+        NuoDB::PreparedStatement* statement = nullptr;
+        try {
+          ADD_COUNT(EXECUTEBATCH_DO, DO, data)
+          SUBTRACT_COUNT(EXECUTEBATCH_DO, DO, data)
+          statement = self->createStatement(sql, Binds(), options.getQueryTimeout());
+          count = self->doExecuteColumns(statement, columns, rows);
+          self->statementCache->release(sql, statement);
+        } catch (std::exception& e) {
+            self->statementCache->discard(statement);
+            SetErrorMessage(e.what());
+            SUBTRACT_COUNT(EXECUTEBATCH_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("ExecuteColumnsWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Value> argv[] = {
+            Nan::Null(),
+            Nan::New<Number>((double)count)
+        };
+        SUBTRACT_COUNT(EXECUTEBATCH_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+  protected:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    Connection* self;
+    BindColumns columns;
+    size_t rows;
+    Options options;
+    std::string error;
+    std::string sql;
+    int64_t count = 0;
+};
+
+/* static */
+NAN_METHOD(Connection::executeColumns)
+{
+    TRACE("Connection::executeColumns");
+    Nan::HandleScope scope;
+    std::string error;
+
+    Connection* self = Nan::ObjectWrap::Unwrap<Connection>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    // first parameter is always a SQL DML string
+    if (!info[0]->IsString()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 0);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    Nan::Utf8String sqlString(info[0].As<String>());
+    std::string sql(*sqlString);
+
+    // second parameter is an array holding the values of each parameter,
+    // one typed array or array per column
+    if (info.Length() < 3 || !info[1]->IsArray()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 1);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    BindColumns columns;
+    size_t rows = 0;
     try {
-        statement = self->createStatement(sql, binds);
-        if (options.getQueryTimeout() != 0) {
-          statement->setQueryTimeout(options.getQueryTimeout());
+        rows = getJsBindColumns(info[1].As<Array>(), columns);
+    } catch (std::exception& e) {
+        Nan::ThrowError(e.what());
+        return;
+    }
+
+    // query options (optional) that can be specified by the user
+    auto infoIdx = 2;
+    Options options;
+    if (info.Length() > infoIdx && !info[infoIdx]->IsFunction()) {
+        try {
+            getJsonOptions(info[infoIdx++].As<Object>(), options);
+        } catch (std::exception& e) {
+            Nan::ThrowError(e.what());
+            return;
         }
+    }
+    try {
+        self->applyOptions(options);
     } catch (std::exception& e) {
         error = e.what();
     }
 
     Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
 
-    ExecuteWorker* worker = new ExecuteWorker(callback, self, statement, options, error, sql);
+    ExecuteColumnsWorker* worker = new ExecuteColumnsWorker(callback, self, std::move(columns), rows, options, error, sql);
     worker->SaveToPersistent("nuodb:Connection", info.This());
     Nan::AsyncQueueWorker(worker);
-    ADD_COUNT(EXECUTE_QUE, QUE, worker->data)
+    ADD_COUNT(EXECUTEBATCH_QUE, QUE, worker->data)
+}
+
+// doExecuteColumns binds each row of the columns and sends them to the
+// database in a single batch, returning the total update count. It runs on
+// a worker thread and must not touch V8.
+int64_t Connection::doExecuteColumns(NuoDB::PreparedStatement* statement, const BindColumns& columns, size_t rows)
+{
+    try {
+        for (size_t row = 0; row < rows; row++) {
+            bindStatementRow(statement, columns, row);
+            statement->addBatch();
+        }
+        const int* results = statement->executeBatch();
+        int64_t total = 0;
+        for (size_t row = 0; row < rows; row++) {
+            if (results[row] > 0) {
+                total += results[row];
+            }
+        }
+        return total;
+    } catch (NuoDB::SQLException& e) {
+        // Execution has failed, see if the failure should consider the connection dead
+        markForFailure(e);
+        throw std::runtime_error(ErrMsg::get(e));
+    }
+}
+
+// isIdentifier is true for a name that can be written unquoted in SQL, as
+// the database folds such names to upper case.
+static bool isIdentifier(const std::string& name)
+{
+    if (name.empty() || !(isalpha((unsigned char)name[0]) || name[0] == '_')) {
+        return false;
+    }
+    for (char c : name) {
+        if (!isalnum((unsigned char)c) && c != '_' && c != '$') {
+            return false;
+        }
+    }
+    return true;
 }
 
-NuoDB::PreparedStatement* Connection::createStatement(std::string sql, Local<Array> binds)
+// isTableName is true for an identifier, optionally qualified by a schema.
+static bool isTableName(const std::string& name)
+{
+    size_t dot = name.find('.');
+    if (dot == std::string::npos) {
+        return isIdentifier(name);
+    }
+    return isIdentifier(name.substr(0, dot)) && isIdentifier(name.substr(dot + 1));
+}
+
+class LoadWorker : public Nan::AsyncWorker
+{
+  public:
+    LoadWorker(Nan::Callback* callback, Connection* self, std::string path, FileFormat format, std::string table,
+               std::string sql, size_t batchSize, Options options, std::string error)
+        : Nan::AsyncWorker(callback), self(self), path(path), format(format), table(table), sql(sql),
+          batchSize(batchSize), options(options), error(error)
+    {
+        TRACE("LoadWorker::LoadWorker");
+        data = manager.getData();
+        COUNT_ADD(data, LOAD_CNT);
+    }
+
+    virtual ~LoadWorker()
+    {
+        TRACE("LoadWorker::~LoadWorker");
+        COUNT_SUB(data, LOAD_CNT);
+    }
+
+    virtual void Execute()
+    {
+        TRACE("LoadWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(LOAD_QUE, QUE, data)
+            return;
+        }
+        int fd = -1;
+        try {
+          ADD_COUNT(LOAD_DO, DO, data)
+          SUBTRACT_COUNT(LOAD_DO, DO, data)
+          fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+          if (fd < 0) {
+              std::string message = ErrMsg::get(ErrMsgType::errLoadFile, strerror(errno));
+              throw std::runtime_error(message);
+          }
+          rows = self->doLoadFrom(fd, format, table, sql, batchSize, options.getQueryTimeout());
+          ::close(fd);
+        } catch (std::exception& e) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            std::string message = ErrMsg::get(ErrMsgType::errLoad, e.what());
+            SetErrorMessage(message.c_str());
+            SUBTRACT_COUNT(LOAD_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("LoadWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Object> result = Nan::New<Object>();
+        Nan::Set(result, Nan::New("rows").ToLocalChecked(), Nan::New<Number>((double)rows));
+        Local<Value> argv[] = {
+            Nan::Null(),
+            result
+        };
+        SUBTRACT_COUNT(LOAD_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+  protected:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    Connection* self;
+    std::string path;
+    FileFormat format;
+    std::string table;
+    std::string sql;
+    size_t batchSize;
+    Options options;
+    std::string error;
+    size_t rows = 0;
+};
+
+// the rows inserted, and committed, at a time by a load
+static const uint32_t LOAD_BATCH_SIZE = 1000;
+
+/**
+ * loadFrom inserts the rows of a file into a table.
+ *
+ * String :                 the path of a CSV or NDJSON file.
+ * Object :                 load options; table names the table the file
+ *                          columns are inserted into, or sql is the
+ *                          statement bound with each row. format is 'csv'
+ *                          (the default) or 'ndjson', and batchSize the
+ *                          number of rows sent and committed at a time.
+ *                          Query options such as queryTimeout also apply.
+ * Function :               an error-first callback, called with the number
+ *                          of rows loaded.
+ */
+NAN_METHOD(Connection::loadFrom)
 {
+    TRACE("Connection::loadFrom");
     Nan::HandleScope scope;
-    Isolate* isolate = Isolate::GetCurrent();
-    Local<Context> ctx = isolate->GetCurrentContext();
+    std::string error;
+
+    Connection* self = Nan::ObjectWrap::Unwrap<Connection>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    // first parameter is always the path of the file
+    if (!info[0]->IsString()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 0);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    Nan::Utf8String pathString(info[0].As<String>());
+    std::string path(*pathString);
+
+    // second parameter holds the load options, the table or SQL at least
+    if (info.Length() < 3 || !info[1]->IsObject()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 1);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    Local<Object> object = info[1].As<Object>();
+    FileFormat format = FILE_CSV;
+    std::string table;
+    std::string sql;
+    size_t batchSize = LOAD_BATCH_SIZE;
+    Options options;
+    try {
+        table = getJsonString(object, "table", "");
+        sql = getJsonString(object, "sql", "");
+        if (table.empty() == sql.empty()) {
+            std::string message = ErrMsg::get(ErrMsgType::errMissingProperty, "table or sql");
+            throw std::runtime_error(message);
+        }
+        if (!table.empty() && !isTableName(table)) {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidPropertyValue, "table");
+            throw std::runtime_error(message);
+        }
+        if (!toFileFormat(getJsonString(object, "format", "csv"), format) || format == FILE_ARROW) {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidPropertyValue, "format");
+            throw std::runtime_error(message);
+        }
+        batchSize = getJsonUint(object, "batchSize", LOAD_BATCH_SIZE);
+        if (batchSize == 0) {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidPropertyValue, "batchSize");
+            throw std::runtime_error(message);
+        }
+        getJsonOptions(object, options);
+    } catch (std::exception& e) {
+        Nan::ThrowError(e.what());
+        return;
+    }
+    try {
+        self->applyOptions(options);
+    } catch (std::exception& e) {
+        error = e.what();
+    }
+
+    Nan::Callback* callback = new Nan::Callback(info[2].As<Function>());
+
+    LoadWorker* worker = new LoadWorker(callback, self, path, format, table, sql, batchSize, options, error);
+    worker->SaveToPersistent("nuodb:Connection", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(LOAD_QUE, QUE, worker->data)
+}
+
+// insertSql returns an INSERT of the named columns into a table. The table
+// and the columns are identifiers written unquoted, so that they match
+// whatever their case in the file.
+static std::string insertSql(const std::string& table, const std::vector<std::string>& names)
+{
+    std::string sql = "INSERT INTO " + table + " (";
+    for (size_t index = 0; index < names.size(); index++) {
+        if (!isIdentifier(names[index])) {
+            std::string message = ErrMsg::get(ErrMsgType::errLoadColumn, (int)index + 1);
+            throw std::runtime_error(message);
+        }
+        if (index > 0) {
+            sql += ", ";
+        }
+        sql += names[index];
+    }
+    sql += ") VALUES (";
+    for (size_t index = 0; index < names.size(); index++) {
+        sql += index > 0 ? ", ?" : "?";
+    }
+    sql += ")";
+    return sql;
+}
+
+// doLoadFrom parses the rows of a file and inserts them in batches, each
+// committed unless the database already commits them, returning the number
+// of rows loaded. Rows of batches already committed stay loaded when a
+// later batch fails, whose own rows are rolled back. It runs on a worker
+// thread and must not touch V8.
+size_t Connection::doLoadFrom(int fd, FileFormat format, const std::string& table, std::string sql,
+                              size_t batchSize, uint32_t queryTimeout)
+{
+    RowReader reader(format, fd);
+    std::vector<Binds> batch;
+    batch.reserve(batchSize);
+    size_t rows = 0;
+    NuoDB::PreparedStatement* statement = nullptr;
+    try {
+        Binds row;
+        bool more = reader.readRow(row);
+        while (more || !batch.empty()) {
+            if (more) {
+                batch.push_back(std::move(row));
+                row.clear();
+                more = reader.readRow(row);
+            }
+            if (batch.size() < batchSize && more) {
+                continue;
+            }
+            if (statement == nullptr) {
+                // the column names are known once a row has been read
+                if (sql.empty()) {
+                    sql = insertSql(table, reader.getNames());
+                }
+                statement = createStatement(sql, Binds(), queryTimeout);
+            }
+            std::vector<int> counts;
+            doExecuteBatch(statement, batch, counts);
+            if (!isAutoCommit()) {
+                doCommit();
+            }
+            rows += batch.size();
+            batch.clear();
+        }
+        if (statement != nullptr) {
+            statementCache->release(sql, statement);
+        }
+    } catch (...) {
+        statementCache->discard(statement);
+        if (!isAutoCommit()) {
+            // the rows the failed batch did insert must not be committed
+            // by the next commit of the application
+            try {
+                doRollback();
+            } catch (std::exception& e) {
+                // the load error is reported rather than this one
+            }
+        }
+        throw;
+    }
+    return rows;
+}
+
+class PrepareWorker : public Nan::AsyncWorker
+{
+  public:
+    PrepareWorker(Nan::Callback* callback, Connection* self, Options options, std::string sql)
+        : Nan::AsyncWorker(callback), self(self), options(options), sql(sql)
+    {
+        TRACE("PrepareWorker::PrepareWorker");
+        data = manager.getData();
+        COUNT_ADD(data, PREPARE_CNT);
+    }
+
+    virtual ~PrepareWorker()
+    {
+        TRACE("PrepareWorker::~PrepareWorker");
+        COUNT_SUB(data, PREPARE_CNT);
+    }
+
+    virtual void Execute()
+    {
+        TRACE("PrepareWorker::Execute");
+        try {
+          ADD_COUNT(PREPARE_DO, DO, data)
+          SUBTRACT_COUNT(PREPARE_DO, DO, data)
+          statement = self->doPrepare(sql);
+        } catch (std::exception& e) {
+            SetErrorMessage(e.what());
+            SUBTRACT_COUNT(PREPARE_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("PrepareWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Value> argv[] = {
+            Nan::Null(),
+            Statement::createFrom(self, statement, options, sql)
+        };
+        SUBTRACT_COUNT(PREPARE_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+  protected:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    Connection* self;
+    NuoDB::PreparedStatement* statement = nullptr;
+    Options options;
+    std::string sql;
+};
+
+/* static */
+NAN_METHOD(Connection::prepare)
+{
+    TRACE("Connection::prepare");
+    Nan::HandleScope scope;
+
+    Connection* self = Nan::ObjectWrap::Unwrap<Connection>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    // first parameter is always a SQL DDL or DML string
+    if (!info[0]->IsString()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 0);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+    Nan::Utf8String sqlString(info[0].As<String>());
+    std::string sql(*sqlString);
+
+    // query options (optional), parsed once here and used by every
+    // execution of the statement
+    auto infoIdx = 1;
+    Options options;
+    if (info.Length() > infoIdx && !info[infoIdx]->IsFunction()) {
+        try {
+            getJsonOptions(info[infoIdx++].As<Object>(), options);
+        } catch (std::exception& e) {
+            Nan::ThrowError(e.what());
+            return;
+        }
+    }
 
+    Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
+
+    PrepareWorker* worker = new PrepareWorker(callback, self, options, sql);
+    worker->SaveToPersistent("nuodb:Connection", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(PREPARE_QUE, QUE, worker->data)
+}
+
+// doPrepare prepares a statement owned by the application rather than the
+// statement cache. It runs on a worker thread and must not touch V8.
+NuoDB::PreparedStatement* Connection::doPrepare(const std::string& sql)
+{
     if (!isConnected()) {
         std::string message = ErrMsg::get(ErrMsgType::errConnectionClosed);
         throw std::runtime_error(message);
     }
 
-    NuoDB::PreparedStatement* statement = nullptr;
     try {
-        statement = connection->prepareStatement(sql.c_str());
-        for (size_t index = 0; index < binds->Length(); index++) {
-            Local<Value> value = binds->Get(ctx, index).ToLocalChecked();
-
-            int sqlIdx = index + 1;
-            int sqlType = Type::fromEsType(typeOf(value));
-
-            // The top-level case statements below correspond to the five
-            // fundamental data types in ES. Within these types we need to
-            // check if it will result in a safe conversion (e.g. Number).
-            switch (sqlType) {
-                case NuoDB::NUOSQL_UNDEFINED:
-                case NuoDB::SqlType::NUOSQL_NULL:
-                    statement->setNull(sqlIdx, NuoDB::NUOSQL_NULL);
-                    break;
-
-                case NuoDB::SqlType::NUOSQL_BOOLEAN:
-                    statement->setBoolean(sqlIdx, toBool(value));
-                    break;
-
-                case NuoDB::SqlType::NUOSQL_DOUBLE:
-                    // If the value can be safely coerced to a sized integer
-                    // or float without loss of precision, send a numeric
-                    // value rather than a string. If we're dealing with
-                    // a number that is larger than can be safely coerced,
-                    // convert it to a string.
-                    if (isInt16(value)) {
-                        statement->setShort(sqlIdx, toInt16(value));
-                    } else if (isInt32(value)) {
-                        statement->setInt(sqlIdx, toInt32(value));
-                    } else if (isFloat(value)) {
-                        statement->setFloat(sqlIdx, toFloat(value));
-                    } else {
-                        statement->setDouble(sqlIdx, toDouble(value));
-                    }
-                    break;
-
-                case NuoDB::SqlType::NUOSQL_VARCHAR: {
-                    statement->setString(sqlIdx, toString(value).c_str());
-                    break;
-                }
-                case NuoDB::NUOSQL_DATE: {
-                    int bufsize = 80;
-                    char buffer[bufsize];
-                    // Initializing buffer to string termination so there is
-                    // no possible unterminated string placed in the buffer.
-                    memset(buffer,'\0',bufsize);
-                    time_t seconds = (time_t)(toInt64(value) / 1000);
-                    struct tm* timeinfo;
-                    timeinfo = localtime(&seconds);
-                    strftime(buffer, bufsize, "%F %T", timeinfo);
-                    int strsize = strlen(buffer);
-                    // buffer = "YYYY-MM-DD HH:MM:SS" -- 19 characters long
-                    int ms = toInt64(value) % 1000;
-                    buffer[strsize] = '.';
-                    buffer[++strsize] = '0' + ms / 100;
-                    ms %= 100;
-                    buffer[++strsize] = '0' + ms / 10;
-                    ms %= 10;
-                    buffer[++strsize] = '0' + ms;
-                    assert (strsize < bufsize);
-
-                    statement->setString(sqlIdx, buffer);
-                    break;
-                }
+        return connection->prepareStatement(sql.c_str());
+    } catch (NuoDB::SQLException& e) {
+        markForFailure(e);
+        throw std::runtime_error(ErrMsg::get(e));
+    }
+}
 
-                default:{
-                    statement->setString(sqlIdx, toString(value).c_str());
-                    break;
-                }
-            }
+// createStatement prepares, or reuses a cached, statement and binds its
+// parameters. It runs on a worker thread and must not touch V8.
+NuoDB::PreparedStatement* Connection::createStatement(const std::string& sql, const Binds& binds, uint32_t queryTimeout,
+                                                     uint32_t maxRows)
+{
+    if (!isConnected()) {
+        std::string message = ErrMsg::get(ErrMsgType::errConnectionClosed);
+        throw std::runtime_error(message);
+    }
+
+    NuoDB::PreparedStatement* statement = statementCache->acquire(sql);
+    try {
+        if (statement == nullptr) {
+            statement = connection->prepareStatement(sql.c_str());
+        }
+        if (queryTimeout != 0) {
+            statement->setQueryTimeout(queryTimeout);
+        }
+        if (maxRows != 0) {
+            statement->setMaxRows(maxRows);
         }
+        bindStatement(statement, binds);
     } catch (NuoDB::SQLException& e) {
+        statementCache->discard(statement);
         throw std::runtime_error(ErrMsg::get(e));
     }
 
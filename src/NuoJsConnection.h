@@ -7,8 +7,14 @@
 #define NUOJS_CONNECTION_H
 
 #include "NuoJsAddon.h"
+#include "NuoJsStatementCache.h"
+#include "NuoJsBinds.h"
+#include "NuoJsOptions.h"
+#include "NuoJsFileFormat.h"
 #include "NuoDB.h"
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace NuoJs
 {
@@ -44,13 +50,37 @@ public:
     static NAN_METHOD(hasFailed);
     bool isFailed() const;
 
+    // applyOptions applies the connection-level settings among the query
+    // options (isolation level, auto commit, read only) to the connection.
+    void applyOptions(Options& options);
+
 private:
 
     static unsigned int restrictedAPI;
     static NAN_METHOD(execute);
     friend class ExecuteWorker;
     bool doExecute(NuoDB::PreparedStatement* statement, std::string sql);
-    NuoDB::PreparedStatement* createStatement(std::string sql, Local<Array> binds);
+    NuoDB::PreparedStatement* createStatement(const std::string& sql, const Binds& binds, uint32_t queryTimeout,
+                                              uint32_t maxRows = 0);
+
+    static NAN_METHOD(executeBatch);
+    friend class ExecuteBatchWorker;
+    void doExecuteBatch(NuoDB::PreparedStatement* statement, const std::vector<Binds>& rows, std::vector<int>& counts);
+
+    static NAN_METHOD(executeColumns);
+    friend class ExecuteColumnsWorker;
+    int64_t doExecuteColumns(NuoDB::PreparedStatement* statement, const BindColumns& columns, size_t rows);
+
+    // Inserts the rows of a CSV or NDJSON file, parsed and bound on a
+    // worker thread, in batches that are each committed.
+    static NAN_METHOD(loadFrom);
+    friend class LoadWorker;
+    size_t doLoadFrom(int fd, FileFormat format, const std::string& table, std::string sql,
+                      size_t batchSize, uint32_t queryTimeout);
+
+    static NAN_METHOD(prepare);
+    friend class PrepareWorker;
+    NuoDB::PreparedStatement* doPrepare(const std::string& sql);
 
     static NAN_METHOD(commit);
     friend class CommitWorker;
@@ -84,10 +114,14 @@ private:
     std::string failureText;
 
     friend class Driver;
+    friend class Statement;
 
     void setIsolationLevel(uint32_t isolation);
 
     class NuoDB::Connection* connection;
+
+    // idle prepared statements, shared with the result sets that borrow them
+    std::shared_ptr<StatementCache> statementCache;
 };
 }
 
@@ -0,0 +1,523 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsCursor.h"
+#include "NuoJsAddon.h"
+#include "NuoJsErrMsg.h"
+#include "NuoJsDateCodec.h"
+#include "NuoJsDecimal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace NuoJs
+{
+Cursor::Cursor(NuoDB::ResultSet* result, const Options& options)
+    : result(result),
+      lobThreshold(options.getLobStreamThreshold()),
+      decimalMode(options.getDecimalMode()),
+      data(NuoJsDataManager::getInstance(false).getData())
+{
+    TRACE("Cursor::Cursor");
+}
+
+Cursor::~Cursor()
+{
+    TRACE("Cursor::~Cursor");
+    GAUGE_SUB(data, BUFFERED_BYTES, bufferedBytes);
+    releaseLobs();
+}
+
+/* static */
+std::unique_ptr<Cursor> Cursor::open(NuoDB::PreparedStatement* statement, size_t fetchSize,
+                                     const Options& options)
+{
+    TRACE("Cursor::open");
+    NuoDB::ResultSet* result = nullptr;
+    try {
+        result = statement->getResultSet();
+    } catch (NuoDB::SQLException& e) {
+        throw std::runtime_error(ErrMsg::get(e));
+    }
+
+    if (result == nullptr) {
+        // if the result set is still null at this point, there is the potential that one connection is being used for multiple queries.
+        throw std::runtime_error("Cannot access result set. Please ensure there is only one actively executing query per connection.");
+    }
+
+    std::unique_ptr<Cursor> cursor(new Cursor(result, options));
+    if (fetchSize > 0) {
+        cursor->fetch(fetchSize);
+    }
+    return cursor;
+}
+
+// Decoders read the value of one column of the current row into a cell.
+// They are specialized by SQL type so the type is resolved once per result
+// set rather than per cell.
+template<int SqlType>
+static void decode(Cursor& cursor, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch);
+
+template<>
+void decode<NuoDB::NUOSQL_SMALLINT>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& /*batch*/)
+{
+    cell.u.i16 = result->getShort(column);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_INTEGER>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& /*batch*/)
+{
+    cell.u.i32 = result->getInt(column);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_BIGINT>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& /*batch*/)
+{
+    cell.u.i64 = result->getLong(column);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_DOUBLE>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& /*batch*/)
+{
+    cell.u.f8 = result->getDouble(column);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_BOOLEAN>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& /*batch*/)
+{
+    cell.u.b = result->getBoolean(column);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_VARCHAR>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    const char* s = result->getString(column);
+    if (!result->wasNull()) {
+        batch.setCodedString(cell, column - 1, s, strlen(s));
+    }
+}
+
+// Binary values are read into a buffer of their own, which is handed to ES
+// as the memory of a Buffer.
+template<>
+void decode<NuoDB::NUOSQL_BLOB>(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    NuoDB::Blob* blob = result->getBlob(column);
+    if (result->wasNull() || blob == nullptr) {
+        return;
+    }
+    try {
+        int length = blob->length();
+        char* bytes = batch.allocateBytes(cell, length);
+        if (length > 0) {
+            blob->getBytes(0, length, reinterpret_cast<unsigned char*>(bytes));
+        }
+    } catch (...) {
+        blob->release();
+        throw;
+    }
+    blob->release();
+}
+
+// Character LOBs no longer than the threshold of the cursor are read in full
+// as strings, longer ones are left to be read in chunks after the fetch.
+template<>
+void decode<NuoDB::NUOSQL_CLOB>(Cursor& cursor, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    NuoDB::Clob* lob = result->getClob(column);
+    if (result->wasNull() || lob == nullptr) {
+        return;
+    }
+    try {
+        size_t length = lob->length();
+        if (length > cursor.getLobThreshold()) {
+            cursor.adoptLob(lob);
+            cell.u.lob = lob;
+            cell.length = Cell::STREAMED;
+            return;
+        }
+        std::string chars(length, '\0');
+        if (length > 0) {
+            lob->getChars(0, (int)length, &chars[0]);
+        }
+        batch.setString(cell, chars.data(), length);
+    } catch (...) {
+        lob->release();
+        throw;
+    }
+    lob->release();
+}
+
+// Decimals are parsed to a scaled integer. As numbers they are returned as
+// doubles when they survive the conversion, as BigInts as the unscaled value
+// and the scale in the cell length. Any other value remains a string.
+template<DecimalMode Mode>
+static void decodeDecimal(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    const char* s = result->getString(column);
+    if (result->wasNull()) {
+        return;
+    }
+    size_t length = strlen(s);
+    ScaledDecimal decimal;
+    if (parseDecimal(s, length, decimal)) {
+        if (Mode == DECIMALS_AS_NUMBER) {
+            if (toNumber(decimal, cell.u.f8)) {
+                cell.sqlType = NuoDB::NUOSQL_DOUBLE;
+                return;
+            }
+        } else {
+            cell.u.i64 = decimal.unscaled;
+            cell.length = decimal.scale;
+            return;
+        }
+    }
+    cell.sqlType = NuoDB::NUOSQL_VARCHAR;
+    batch.setString(cell, s, length);
+}
+
+// Date, time and time stamp values are parsed to milliseconds since the
+// epoch, held in the cell with a length of zero. A value in an unexpected
+// layout is kept as a string, parsed by the ES Date constructor instead.
+typedef bool (*DateParser)(const char* s, size_t length, double& millis);
+
+template<DateParser Parse>
+static void decodeDate(Cursor& /*cursor*/, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    const char* s = result->getString(column);
+    if (result->wasNull()) {
+        return;
+    }
+    size_t length = strlen(s);
+    if (Parse(s, length, cell.u.f8)) {
+        cell.length = 0;
+    } else if (length == 0) {
+        cell.u.f8 = NAN;
+        cell.length = 0;
+    } else {
+        batch.setString(cell, s, length);
+    }
+}
+
+template<>
+void decode<NuoDB::NUOSQL_DATE>(Cursor& cursor, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    decodeDate<parseDate>(cursor, result, column, cell, batch);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_TIME>(Cursor& cursor, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    decodeDate<parseTime>(cursor, result, column, cell, batch);
+}
+
+template<>
+void decode<NuoDB::NUOSQL_TIMESTAMP>(Cursor& cursor, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch)
+{
+    decodeDate<parseTimestamp>(cursor, result, column, cell, batch);
+}
+
+// getDecoder returns the decoder of a column, and the SQL type of the
+// values it produces. Types without a native decoder are read as strings.
+static Column::Decoder getDecoder(int sqlType, size_t lobThreshold, DecimalMode decimalMode, int& valueType)
+{
+    valueType = sqlType;
+    switch (sqlType) {
+        case NuoDB::NUOSQL_SMALLINT:
+            return decode<NuoDB::NUOSQL_SMALLINT>;
+
+        case NuoDB::NUOSQL_INTEGER:
+            return decode<NuoDB::NUOSQL_INTEGER>;
+
+        case NuoDB::NUOSQL_BIGINT:
+            return decode<NuoDB::NUOSQL_BIGINT>;
+
+        case NuoDB::NUOSQL_FLOAT: // AN ALIAS FOR DOUBLE!!!
+        case NuoDB::NUOSQL_DOUBLE:
+            return decode<NuoDB::NUOSQL_DOUBLE>;
+
+        case NuoDB::NUOSQL_BOOLEAN:
+            return decode<NuoDB::NUOSQL_BOOLEAN>;
+
+        case NuoDB::NUOSQL_DATE:
+            return decode<NuoDB::NUOSQL_DATE>;
+
+        case NuoDB::NUOSQL_TIME:
+            return decode<NuoDB::NUOSQL_TIME>;
+
+        case NuoDB::NUOSQL_TIMESTAMP:
+            return decode<NuoDB::NUOSQL_TIMESTAMP>;
+
+        case NuoDB::NUOSQL_CLOB:
+        case NuoDB::NUOSQL_LONGVARCHAR:
+            if (lobThreshold > 0) {
+                valueType = NuoDB::NUOSQL_CLOB;
+                return decode<NuoDB::NUOSQL_CLOB>;
+            }
+            valueType = NuoDB::NUOSQL_VARCHAR;
+            return decode<NuoDB::NUOSQL_VARCHAR>;
+
+        case NuoDB::NUOSQL_CHAR:
+        case NuoDB::NUOSQL_VARCHAR:
+            return decode<NuoDB::NUOSQL_VARCHAR>;
+
+        case NuoDB::NUOSQL_NUMERIC:
+        case NuoDB::NUOSQL_DECIMAL:
+            valueType = NuoDB::NUOSQL_DECIMAL;
+            switch (decimalMode) {
+                case DECIMALS_AS_NUMBER:
+                    return decodeDecimal<DECIMALS_AS_NUMBER>;
+                case DECIMALS_AS_BIGINT:
+                    return decodeDecimal<DECIMALS_AS_BIGINT>;
+                default:
+                    valueType = NuoDB::NUOSQL_VARCHAR;
+                    return decode<NuoDB::NUOSQL_VARCHAR>;
+            }
+
+        case NuoDB::NUOSQL_BLOB:
+        case NuoDB::NUOSQL_BINARY:
+        case NuoDB::NUOSQL_VARBINARY:
+        case NuoDB::NUOSQL_LONGVARBINARY:
+            valueType = NuoDB::NUOSQL_BLOB;
+            return decode<NuoDB::NUOSQL_BLOB>;
+
+        default:
+            valueType = NuoDB::NUOSQL_VARCHAR;
+            return decode<NuoDB::NUOSQL_VARCHAR>;
+    }
+}
+
+void Cursor::describe()
+{
+    TRACE("Cursor::describe");
+    NuoDB::ResultSetMetaData* metaData = result->getMetaData();
+    int count = metaData->getColumnCount();
+    columns.resize(count);
+    for (int index = 0; index < count; index++) {
+        Column& column = columns[index];
+        int sqlType = metaData->getColumnType(index + 1);
+        column.name = metaData->getColumnLabel(index + 1);
+        column.table = metaData->getTableName(index + 1);
+        column.decoder = getDecoder(sqlType, lobThreshold, decimalMode, column.sqlType);
+    }
+    described = true;
+}
+
+// Rows are made visible to the main event loop in batches of this many rows,
+// or sooner when the fetch stops.
+static const size_t PUBLISH_ROWS = 1024;
+
+void Cursor::publish(RowBatch& batch)
+{
+    if (batch.size() == 0) {
+        return;
+    }
+    batch.releaseDictionaries();
+    std::lock_guard<std::mutex> guard(rowsMutex);
+    bufferedRows += batch.size();
+    bufferedBytes += batch.getBytes();
+    GAUGE_ADD(data, BUFFERED_BYTES, batch.getBytes());
+    batches.push_back(std::move(batch));
+}
+
+void Cursor::fetch(size_t count, size_t maxBytes)
+{
+    TRACE("Cursor::fetch");
+    std::lock_guard<std::mutex> fetchGuard(fetchMutex);
+    if (!failure.empty()) {
+        throw std::runtime_error(failure);
+    }
+    if (exhausted || result == nullptr) {
+        return;
+    }
+
+    try {
+        if (!described) {
+            describe();
+        }
+        // date values are parsed in the time zone of this fetch
+        checkLocalZone();
+        bool fetchAll = count == 0;
+        size_t width = columns.size();
+        size_t buffered;
+        size_t bytes;
+        {
+            std::lock_guard<std::mutex> guard(rowsMutex);
+            buffered = bufferedRows;
+            bytes = bufferedBytes;
+        }
+        RowBatch batch(width);
+        while (!closing) {
+            // the main event loop may take rows during a read-ahead, which
+            // then stops early; any other fetch runs while no rows are taken
+            if (!fetchAll && buffered + batch.size() >= count) {
+                break;
+            }
+            if (maxBytes > 0 && bytes + batch.getBytes() >= maxBytes) {
+                break;
+            }
+            if (!result->next()) {
+                exhausted = true;
+                break;
+            }
+            Cell* row = batch.addRow();
+            for (size_t index = 0; index < width; index++) {
+                const Column& column = columns[index];
+                // a decoder may change the type of the value it reads
+                row[index].sqlType = column.sqlType;
+                column.decoder(*this, result, (int)index + 1, row[index], batch);
+                // if the last value was null, set the value to null...
+                if (result->wasNull()) {
+                    row[index].sqlType = NuoDB::NUOSQL_NULL;
+                }
+            }
+            if (batch.size() >= PUBLISH_ROWS) {
+                buffered += batch.size();
+                bytes += batch.getBytes();
+                publish(batch);
+                batch = RowBatch(width);
+            }
+        }
+        publish(batch);
+    } catch (NuoDB::SQLException& e) {
+        failure = ErrMsg::get(e);
+        throw std::runtime_error(failure);
+    }
+}
+
+const Columns& Cursor::getColumns() const
+{
+    return columns;
+}
+
+bool Cursor::hasRows(size_t count) const
+{
+    // read the buffer size first, the fetch may complete in between
+    size_t buffered = getBufferedRows();
+    return exhausted || (count > 0 && buffered >= count);
+}
+
+RowBatches Cursor::take(size_t count)
+{
+    std::lock_guard<std::mutex> guard(rowsMutex);
+    RowBatches taken;
+    if (count == 0 || count >= bufferedRows) {
+        taken.swap(batches);
+        takenBytes += bufferedBytes;
+        GAUGE_SUB(data, BUFFERED_BYTES, bufferedBytes);
+        bufferedRows = 0;
+        bufferedBytes = 0;
+        return taken;
+    }
+    size_t before = bufferedBytes;
+    while (count > 0) {
+        RowBatch& front = batches.front();
+        size_t bytes = front.getBytes();
+        if (front.size() <= count) {
+            count -= front.size();
+            bufferedRows -= front.size();
+            bufferedBytes -= bytes;
+            taken.push_back(std::move(front));
+            batches.pop_front();
+        } else {
+            taken.push_back(front.split(count));
+            bufferedRows -= count;
+            bufferedBytes -= bytes - front.getBytes();
+            count = 0;
+        }
+    }
+    takenBytes += before - bufferedBytes;
+    GAUGE_SUB(data, BUFFERED_BYTES, before - bufferedBytes);
+    return taken;
+}
+
+bool Cursor::isExhausted() const
+{
+    return exhausted;
+}
+
+size_t Cursor::getBufferedRows() const
+{
+    std::lock_guard<std::mutex> guard(rowsMutex);
+    return bufferedRows;
+}
+
+size_t Cursor::getBufferedBytes() const
+{
+    std::lock_guard<std::mutex> guard(rowsMutex);
+    return bufferedBytes;
+}
+
+size_t Cursor::getTakenBytes() const
+{
+    std::lock_guard<std::mutex> guard(rowsMutex);
+    return takenBytes;
+}
+
+void Cursor::close()
+{
+    TRACE("Cursor::close");
+    closing = true;
+    std::lock_guard<std::mutex> fetchGuard(fetchMutex);
+    {
+        std::lock_guard<std::mutex> guard(rowsMutex);
+        batches.clear();
+        GAUGE_SUB(data, BUFFERED_BYTES, bufferedBytes);
+        bufferedRows = 0;
+        bufferedBytes = 0;
+    }
+    releaseLobs();
+    if (result != nullptr) {
+        result->close();
+        result = nullptr;
+    }
+}
+
+size_t Cursor::getLobThreshold() const
+{
+    return lobThreshold;
+}
+
+void Cursor::adoptLob(NuoDB::Clob* lob)
+{
+    // called by decoders, while fetchMutex is held
+    lobs.insert(lob);
+}
+
+size_t Cursor::readLob(NuoDB::Clob* lob, size_t offset, size_t length, char* buffer, bool& end)
+{
+    TRACE("Cursor::readLob");
+    std::lock_guard<std::mutex> fetchGuard(fetchMutex);
+    auto it = lobs.find(lob);
+    if (it == lobs.end()) {
+        std::string message = ErrMsg::get(ErrMsgType::errLobClosed);
+        throw std::runtime_error(message);
+    }
+    try {
+        size_t total = lob->length();
+        size_t count = offset < total ? std::min(length, total - offset) : 0;
+        if (count > 0) {
+            lob->getChars((int)offset, (int)count, buffer);
+        }
+        end = offset + count >= total;
+        if (end) {
+            lobs.erase(it);
+            lob->release();
+        }
+        return count;
+    } catch (NuoDB::SQLException& e) {
+        throw std::runtime_error(ErrMsg::get(e));
+    }
+}
+
+void Cursor::releaseLobs()
+{
+    for (NuoDB::Clob* lob : lobs) {
+        lob->release();
+    }
+    lobs.clear();
+}
+} // namespace NuoJs
@@ -0,0 +1,130 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_CURSOR_H
+#define NUOJS_CURSOR_H
+
+#include "NuoJsRowBatch.h"
+#include "NuoJsOptions.h"
+#include "NuoJsData.h"
+#include "NuoDB.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace NuoJs
+{
+class Cursor;
+
+// Column describes a column of a result set, read once per result set, and
+// the decoder that reads its values. Rows then hold only the values.
+struct Column
+{
+    typedef void (*Decoder)(Cursor& cursor, NuoDB::ResultSet* result, int column, Cell& cell, RowBatch& batch);
+
+    std::string name;
+    std::string table;
+    // the type of the values, which may differ from the declared type
+    int sqlType = NuoDB::NUOSQL_NULL;
+    Decoder decoder = nullptr;
+};
+typedef std::vector<Column> Columns;
+
+// Cursor reads rows of a database result set into a buffer of row batches.
+// Fetching runs on worker threads and never touches V8; rows are taken from
+// the buffer on the main event loop.
+//
+// A background read-ahead may fetch while the main event loop takes rows,
+// so the buffer is guarded by its own lock that is never held across a
+// round trip to the database. Fetches, and closing, are serialized by a
+// second lock only taken on worker threads.
+class Cursor
+{
+public:
+    Cursor(NuoDB::ResultSet* result, const Options& options);
+    ~Cursor();
+
+    // open returns a cursor on the current result of an executed statement,
+    // holding up to fetchSize rows fetched in advance. The options choose
+    // how values are decoded.
+    static std::unique_ptr<Cursor> open(NuoDB::PreparedStatement* statement, size_t fetchSize,
+                                        const Options& options);
+
+    // fetch buffers rows until count rows are available, or all remaining
+    // rows when count is zero. A non-zero maxBytes also stops the fetch once
+    // the buffered rows hold that many bytes.
+    void fetch(size_t count, size_t maxBytes = 0);
+
+    // hasRows is true when a request for count rows can be answered from
+    // the buffer alone.
+    bool hasRows(size_t count) const;
+
+    // take removes up to count rows from the buffer, all rows when count is
+    // zero. Whole batches are moved out; at most one batch is split.
+    RowBatches take(size_t count);
+
+    bool isExhausted() const;
+
+    // getColumns describes the columns of the rows taken from the buffer.
+    // It is complete once the first fetch has returned.
+    const Columns& getColumns() const;
+
+    // the number of rows, and an estimate of their size, in the buffer
+    size_t getBufferedRows() const;
+    size_t getBufferedBytes() const;
+
+    // the estimated size of all rows taken from the buffer so far
+    size_t getTakenBytes() const;
+
+    void close();
+
+    // Character LOBs left to be streamed are owned by the cursor, which
+    // releases them once read to the end or when the cursor closes. Reads
+    // are serialized with fetches and run on worker threads.
+    size_t getLobThreshold() const;
+    void adoptLob(NuoDB::Clob* lob);
+    size_t readLob(NuoDB::Clob* lob, size_t offset, size_t length, char* buffer, bool& end);
+
+private:
+    NuoDB::ResultSet* result;
+    size_t lobThreshold;
+    DecimalMode decimalMode;
+
+    // guarded by fetchMutex
+    std::unordered_set<NuoDB::Clob*> lobs;
+    void releaseLobs();
+
+    void describe();
+    Columns columns;
+    bool described = false;
+
+    // the buffered bytes are also reported by the BUFFERED_BYTES gauge
+    mutable std::mutex rowsMutex;
+    RowBatches batches;
+    size_t bufferedRows = 0;
+    size_t bufferedBytes = 0;
+    size_t takenBytes = 0;
+    NuoJsData* data;
+    void publish(RowBatch& batch);
+
+    std::mutex fetchMutex;
+
+    // set once the result set has been read to the end
+    std::atomic<bool> exhausted{false};
+
+    // set when close is waiting for a fetch to finish
+    std::atomic<bool> closing{false};
+
+    // a failed fetch is reported again by later fetches
+    std::string failure;
+};
+} // namespace NuoJs
+
+#endif
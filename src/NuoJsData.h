@@ -39,6 +39,14 @@
 // QUE for how many API calls are ready to execute and/or are executing
 // DO for how many API calls are currently running on an Node.js Asynchronous thread
 //
+// The STMTCACHE counters describe the per-connection prepared statement caches,
+// SIZE is a gauge of idle cached statements across all connections, while HIT,
+// MISS and EVICT only accumulate a total.
+//
+// BUFFERED_BYTES is a gauge of the estimated size of the rows fetched and held
+// by all result sets, not yet handed to the application; its total is the
+// number of bytes ever buffered.
+//
 #define NUOJS_DATA_NAMES_LIST(X)\
   X(NUOJS_DATA_NAMES_START)	\
   X(WAIT)			\
@@ -50,6 +58,9 @@
   X(GETROWS_CNT)		\
   X(GETROWS_QUE)		\
   X(GETROWS_DO)			\
+  X(PREFETCH_CNT)		\
+  X(PREFETCH_QUE)		\
+  X(PREFETCH_DO)		\
   X(RESULTSETCLOSE_CNT)		\
   X(RESULTSETCLOSE_QUE)		\
   X(RESULTSETCLOSE_DO)		\
@@ -65,6 +76,32 @@
   X(CONNECT_CNT)		\
   X(CONNECT_QUE)		\
   X(CONNECT_DO)			\
+  X(EXECUTEBATCH_CNT)		\
+  X(EXECUTEBATCH_QUE)		\
+  X(EXECUTEBATCH_DO)		\
+  X(PREPARE_CNT)		\
+  X(PREPARE_QUE)		\
+  X(PREPARE_DO)			\
+  X(STATEMENTCLOSE_CNT)		\
+  X(STATEMENTCLOSE_QUE)		\
+  X(STATEMENTCLOSE_DO)		\
+  X(LOBREAD_CNT)		\
+  X(LOBREAD_QUE)		\
+  X(LOBREAD_DO)			\
+  X(EXPORT_CNT)			\
+  X(EXPORT_QUE)			\
+  X(EXPORT_DO)			\
+  X(LOAD_CNT)			\
+  X(LOAD_QUE)			\
+  X(LOAD_DO)			\
+  X(ARROW_CNT)			\
+  X(ARROW_QUE)			\
+  X(ARROW_DO)			\
+  X(STMTCACHE_SIZE)		\
+  X(STMTCACHE_HIT)		\
+  X(STMTCACHE_MISS)		\
+  X(STMTCACHE_EVICT)		\
+  X(BUFFERED_BYTES)		\
   X(NUOJS_DATA_NAMES_END)
 
 // Macro to increment the amount of active calls to an API
@@ -87,6 +124,30 @@
     }
 //    std::cout <<  #index << " " << (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].current.load(std::memory_order_relaxed) << std::endl;
 
+// Macro to count an event that has no duration, such as a statement cache hit.
+// Only the total property of the Counter is updated.
+#define COUNT_TOTAL(arr, index) \
+    if (NuoJsDataManager::asyncCounters) { \
+    (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].total++; \
+    }
+
+// Macros to move a gauge measured in units other than API calls, such as
+// bytes, by an amount. Adding also updates the total and highwater mark.
+#define GAUGE_ADD(arr, index, amount) \
+    if (NuoJsDataManager::asyncCounters) { \
+    (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].current += (amount); \
+    (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].total += (amount); \
+    if ((arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].current.load(std::memory_order_relaxed) > (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].high.load(std::memory_order_relaxed)) { \
+      (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].high.store((arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].current.load(std::memory_order_relaxed)); \
+      (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].hightime.store(std::chrono::system_clock::now(), std::memory_order_relaxed); \
+    } \
+    }
+
+#define GAUGE_SUB(arr, index, amount) \
+    if (NuoJsDataManager::asyncCounters) { \
+    (arr)->names[static_cast<unsigned int>(NuoJsDataNames::index)].current -= (amount); \
+    }
+
 // Macro used to update WAIT, which indicates how many API calls are waiting for an Asynchronous Thread to process
 // The Macro will also set the highwater mark for the counter and the time the setting is made
 #define WAIT_REFRESH(arr) \
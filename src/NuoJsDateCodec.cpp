@@ -0,0 +1,249 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsDateCodec.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+namespace NuoJs
+{
+static const int64_t MS_PER_SECOND = 1000;
+static const int64_t MS_PER_MINUTE = 60 * MS_PER_SECOND;
+static const int64_t MS_PER_HOUR = 60 * MS_PER_MINUTE;
+static const int64_t MS_PER_DAY = 24 * MS_PER_HOUR;
+
+// daysFromCivil returns the days since 1970-01-01 of a proleptic Gregorian
+// date. See: http://howardhinnant.github.io/date_algorithms.html
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+// civilFromDays is the inverse of daysFromCivil.
+static void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d)
+{
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = (int64_t)yoe + era * 400 + (m <= 2);
+}
+
+// digits reads a fixed number of decimal digits, returning false if any
+// character is not a digit.
+static inline bool digits(const char* s, int count, unsigned& value)
+{
+    value = 0;
+    for (int index = 0; index < count; index++) {
+        unsigned digit = (unsigned)(s[index] - '0');
+        if (digit > 9) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+static bool parseDateFields(const char* s, int64_t& days)
+{
+    unsigned y, m, d;
+    if (!digits(s, 4, y) || s[4] != '-' || !digits(s + 5, 2, m) || s[7] != '-' || !digits(s + 8, 2, d)) {
+        return false;
+    }
+    if (m < 1 || m > 12 || d < 1 || d > 31) {
+        return false;
+    }
+    days = daysFromCivil(y, m, d);
+    return true;
+}
+
+// parseTimeFields parses "HH:MM:SS[.f...]" to milliseconds into the day.
+static bool parseTimeFields(const char* s, size_t length, int64_t& millis)
+{
+    unsigned h, m, sec;
+    if (length < 8 || !digits(s, 2, h) || s[2] != ':' || !digits(s + 3, 2, m) || s[5] != ':' || !digits(s + 6, 2, sec)) {
+        return false;
+    }
+    if (h > 24 || m > 59 || sec > 59) {
+        return false;
+    }
+    unsigned ms = 0;
+    if (length > 8) {
+        if (s[8] != '.' || length == 9) {
+            return false;
+        }
+        // up to three digits of the fraction are kept, the rest truncated
+        size_t index = 9;
+        for (; index < length; index++) {
+            unsigned digit = (unsigned)(s[index] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            if (index < 12) {
+                ms = ms * 10 + digit;
+            }
+        }
+        for (; index < 12; index++) {
+            ms *= 10;
+        }
+    }
+    millis = h * MS_PER_HOUR + m * MS_PER_MINUTE + sec * MS_PER_SECOND + ms;
+    return true;
+}
+
+// Offsets of local time are cached per thread in buckets of 15 minutes of
+// UTC, the granularity of time zone transitions since offsets became whole
+// quarter hours. A bucket holding a transition, as in zones still on local
+// mean time, is marked mixed and its offsets are looked up each time.
+static const int64_t OFFSET_BUCKET = 15 * MS_PER_MINUTE;
+static const size_t OFFSET_CACHE_SIZE = 256;
+
+struct OffsetEntry {
+    int64_t bucket;
+    int64_t offset;
+    bool valid;
+    bool mixed;
+};
+static thread_local OffsetEntry offsetCache[OFFSET_CACHE_SIZE] = {};
+
+// the value of TZ the offsets were cached for
+static thread_local bool zoneKnown = false;
+static thread_local bool zoneSet = false;
+static thread_local std::string zone;
+
+void checkLocalZone()
+{
+    // Node applies a change of process.env.TZ with tzset, which localtime_r
+    // then follows; the offsets cached for the previous zone are dropped
+    const char* tz = getenv("TZ");
+    if (zoneKnown && zoneSet == (tz != nullptr) && (tz == nullptr || zone == tz)) {
+        return;
+    }
+    zoneKnown = true;
+    zoneSet = tz != nullptr;
+    zone = tz != nullptr ? tz : "";
+    for (OffsetEntry& entry : offsetCache) {
+        entry.valid = false;
+    }
+}
+
+static int64_t lookupOffset(int64_t seconds)
+{
+    time_t t = (time_t)seconds;
+    struct tm timeinfo;
+    localtime_r(&t, &timeinfo);
+    return (int64_t)timeinfo.tm_gmtoff * MS_PER_SECOND;
+}
+
+static int64_t floorDiv(int64_t value, int64_t divisor)
+{
+    return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+int64_t getLocalOffset(int64_t millis)
+{
+    int64_t bucket = floorDiv(millis, OFFSET_BUCKET);
+    OffsetEntry& entry = offsetCache[(uint64_t)bucket % OFFSET_CACHE_SIZE];
+    if (!entry.valid || entry.bucket != bucket) {
+        int64_t first = bucket * OFFSET_BUCKET / MS_PER_SECOND;
+        int64_t last = first + OFFSET_BUCKET / MS_PER_SECOND - 1;
+        entry.bucket = bucket;
+        entry.offset = lookupOffset(first);
+        entry.mixed = lookupOffset(last) != entry.offset;
+        entry.valid = true;
+    }
+    if (entry.mixed) {
+        return lookupOffset(floorDiv(millis, MS_PER_SECOND));
+    }
+    return entry.offset;
+}
+
+// localToUtc converts a local time, given as if it were UTC, to UTC. The
+// offsets either side of the estimate are tried, which resolves a time
+// repeated when clocks go back to its earlier instant, and a time skipped
+// when clocks go forward using the offset before the change, as the ES
+// Date parser does.
+static double localToUtc(int64_t local)
+{
+    int64_t estimate = local - getLocalOffset(local);
+    int64_t before = getLocalOffset(estimate - 6 * MS_PER_HOUR);
+    int64_t after = getLocalOffset(estimate + 6 * MS_PER_HOUR);
+    if (before != after && getLocalOffset(local - before) != before &&
+        getLocalOffset(local - after) == after) {
+        return (double)(local - after);
+    }
+    return (double)(local - before);
+}
+
+bool parseDate(const char* s, size_t length, double& millis)
+{
+    int64_t days;
+    if (length != 10 || !parseDateFields(s, days)) {
+        return false;
+    }
+    millis = (double)(days * MS_PER_DAY);
+    return true;
+}
+
+bool parseTime(const char* s, size_t length, double& millis)
+{
+    int64_t time;
+    if (!parseTimeFields(s, length, time)) {
+        return false;
+    }
+    millis = localToUtc(time);
+    return true;
+}
+
+bool parseTimestamp(const char* s, size_t length, double& millis)
+{
+    int64_t days;
+    int64_t time;
+    if (length < 19 || !parseDateFields(s, days) || (s[10] != ' ' && s[10] != 'T') ||
+        !parseTimeFields(s + 11, length - 11, time)) {
+        return false;
+    }
+    millis = localToUtc(days * MS_PER_DAY + time);
+    return true;
+}
+
+// formatFields formats milliseconds since the epoch, with no offset
+// applied, as "YYYY-MM-DD<separator>HH:MM:SS.fff<suffix>".
+static void formatFields(int64_t millis, char separator, const char* suffix, char* buffer, size_t bufsize)
+{
+    int64_t days = millis >= 0 ? millis / MS_PER_DAY : (millis - MS_PER_DAY + 1) / MS_PER_DAY;
+    int64_t time = millis - days * MS_PER_DAY;
+    int64_t y;
+    unsigned m, d;
+    civilFromDays(days, y, m, d);
+    snprintf(buffer, bufsize, "%04d-%02u-%02u%c%02d:%02d:%02d.%03d%s",
+             (int)y, m, d, separator,
+             (int)(time / MS_PER_HOUR), (int)(time / MS_PER_MINUTE % 60),
+             (int)(time / MS_PER_SECOND % 60), (int)(time % MS_PER_SECOND), suffix);
+}
+
+void formatTimestamp(int64_t millis, char* buffer, size_t bufsize)
+{
+    checkLocalZone();
+    formatFields(millis + getLocalOffset(millis), ' ', "", buffer, bufsize);
+}
+
+void formatIsoString(int64_t millis, char* buffer, size_t bufsize)
+{
+    formatFields(millis, 'T', "Z", buffer, bufsize);
+}
+} // namespace NuoJs
@@ -0,0 +1,51 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_DATECODEC_H
+#define NUOJS_DATECODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace NuoJs
+{
+// The date codec converts between the text form of SQL DATE, TIME and
+// TIMESTAMP values and milliseconds since the epoch, natively and without
+// V8, so that it may run on worker threads. It follows the rules of the ES
+// Date parser for these layouts: a date alone is UTC midnight, a date and
+// time or a time alone is local time, and fractions of a millisecond are
+// truncated.
+
+// parseDate parses "YYYY-MM-DD", returning false for any other layout.
+bool parseDate(const char* s, size_t length, double& millis);
+
+// parseTime parses "HH:MM:SS[.f...]" as a local time on 1970-01-01,
+// returning false for any other layout.
+bool parseTime(const char* s, size_t length, double& millis);
+
+// parseTimestamp parses "YYYY-MM-DD HH:MM:SS[.f...]" as a local time,
+// returning false for any other layout.
+bool parseTimestamp(const char* s, size_t length, double& millis);
+
+// formatTimestamp formats milliseconds since the epoch as a local time
+// stamp, "YYYY-MM-DD HH:MM:SS.fff". The buffer must hold 24 characters.
+void formatTimestamp(int64_t millis, char* buffer, size_t bufsize);
+
+// formatIsoString formats milliseconds since the epoch as UTC in the layout
+// of Date.prototype.toISOString, "YYYY-MM-DDTHH:MM:SS.fffZ", for years 0 to
+// 9999. The buffer must hold 25 characters.
+void formatIsoString(int64_t millis, char* buffer, size_t bufsize);
+
+// getLocalOffset returns the offset of local time from UTC, in milliseconds,
+// at an instant. Offsets are cached per thread.
+int64_t getLocalOffset(int64_t millis);
+
+// checkLocalZone drops the offsets cached by the calling thread when TZ has
+// changed since they were cached. Parsing relies on the caller to check once
+// per batch of values; formatTimestamp checks by itself.
+void checkLocalZone();
+} // namespace NuoJs
+
+#endif
@@ -0,0 +1,234 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsDecimal.h"
+
+#include <charconv>
+#include <cstdlib>
+
+namespace NuoJs
+{
+// powers of ten exactly representable as doubles
+static const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const uint32_t MAX_EXACT_POWER = 22;
+
+// the largest number of significant digits that always survive a round
+// trip through a double
+static const uint32_t MAX_NUMBER_DIGITS = 15;
+
+static inline bool isDigit(char c)
+{
+    return (unsigned)(c - '0') <= 9;
+}
+
+// appendDigit appends a digit to a magnitude, returning false on overflow.
+static inline bool appendDigit(uint64_t& magnitude, uint32_t& digits, unsigned digit)
+{
+    if (magnitude > (UINT64_MAX - digit) / 10) {
+        return false;
+    }
+    magnitude = magnitude * 10 + digit;
+    if (magnitude != 0) {
+        digits++;
+    }
+    return true;
+}
+
+bool parseDecimal(const char* s, size_t length, ScaledDecimal& decimal)
+{
+    const char* p = s;
+    const char* end = s + length;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    // The magnitude is accumulated unsigned, so that INT64_MIN fits. Zeros
+    // after the point are held back until a non-zero digit follows, so
+    // that trailing zeros of a large scale do not overflow the magnitude.
+    uint64_t magnitude = 0;
+    uint32_t digits = 0;
+    int64_t scale = 0;
+    uint32_t pendingZeros = 0;
+    bool seenDigit = false;
+    bool seenPoint = false;
+    for (; p < end; p++) {
+        if (isDigit(*p)) {
+            seenDigit = true;
+            unsigned digit = (unsigned)(*p - '0');
+            if (seenPoint && digit == 0) {
+                pendingZeros++;
+                continue;
+            }
+            for (; pendingZeros > 0; pendingZeros--) {
+                if (!appendDigit(magnitude, digits, 0)) {
+                    return false;
+                }
+                scale++;
+            }
+            if (!appendDigit(magnitude, digits, digit)) {
+                return false;
+            }
+            if (seenPoint) {
+                scale++;
+            }
+        } else if (*p == '.' && !seenPoint) {
+            seenPoint = true;
+        } else {
+            break;
+        }
+    }
+    if (!seenDigit) {
+        return false;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            p++;
+        }
+        if (p == end) {
+            return false;
+        }
+        int64_t exponent = 0;
+        for (; p < end && isDigit(*p); p++) {
+            exponent = exponent * 10 + (*p - '0');
+            if (exponent > 1000) {
+                return false;
+            }
+        }
+        scale += negativeExponent ? exponent : -exponent;
+    }
+    if (p != end) {
+        return false;
+    }
+
+    // a negative scale is folded into the unscaled value
+    for (; scale < 0; scale++) {
+        if (!appendDigit(magnitude, digits, 0)) {
+            return false;
+        }
+    }
+    // trailing zeros are kept, as long as they fit
+    for (; pendingZeros > 0 && magnitude <= (uint64_t)INT64_MAX / 10; pendingZeros--) {
+        appendDigit(magnitude, digits, 0);
+        scale++;
+    }
+    if (scale > UINT32_MAX) {
+        return false;
+    }
+
+    if (negative) {
+        if (magnitude > (uint64_t)INT64_MAX + 1) {
+            return false;
+        }
+        decimal.unscaled = (int64_t)(0 - magnitude);
+    } else {
+        if (magnitude > (uint64_t)INT64_MAX) {
+            return false;
+        }
+        decimal.unscaled = (int64_t)magnitude;
+    }
+    decimal.scale = (uint32_t)scale;
+    decimal.digits = digits;
+    return true;
+}
+
+bool toNumber(const ScaledDecimal& decimal, double& number)
+{
+    // trailing zeros do not count against the significant digits
+    int64_t unscaled = decimal.unscaled;
+    uint32_t scale = decimal.scale;
+    uint32_t digits = decimal.digits;
+    while (scale > 0 && unscaled % 10 == 0 && unscaled != 0) {
+        unscaled /= 10;
+        scale--;
+        digits--;
+    }
+    if (digits > MAX_NUMBER_DIGITS || scale > MAX_EXACT_POWER) {
+        return false;
+    }
+    // both operands are exact, so the quotient is correctly rounded
+    number = (double)unscaled / POWERS_OF_TEN[scale];
+    return true;
+}
+
+void appendDecimal(int64_t unscaled, uint32_t scale, std::string& out)
+{
+    char buffer[32];
+    uint64_t magnitude = unscaled < 0 ? 0 - (uint64_t)unscaled : (uint64_t)unscaled;
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), magnitude);
+    size_t digits = result.ptr - buffer;
+    if (unscaled < 0) {
+        out += '-';
+    }
+    if (digits <= scale) {
+        out += "0.";
+        out.append(scale - digits, '0');
+        out.append(buffer, digits);
+    } else {
+        out.append(buffer, digits - scale);
+        if (scale > 0) {
+            out += '.';
+            out.append(buffer + digits - scale, scale);
+        }
+    }
+}
+
+void appendNumber(double value, std::string& out)
+{
+    if (value == 0) {
+        // as in ES, negative zero is written as 0
+        out += '0';
+        return;
+    }
+    // the shortest digits that read back as the same double, as d.ddde+x
+    char buffer[32];
+    std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+    const char* p = buffer;
+    if (*p == '-') {
+        out += '-';
+        p++;
+    }
+    char digits[20];
+    int k = 0;
+    for (; *p != 'e'; p++) {
+        if (*p != '.') {
+            digits[k++] = *p;
+        }
+    }
+    int exponent = 0;
+    std::from_chars(p[1] == '+' ? p + 2 : p + 1, result.ptr, exponent);
+    // the decimal point follows the first n digits
+    int n = exponent + 1;
+    if (k <= n && n <= 21) {
+        out.append(digits, k);
+        out.append(n - k, '0');
+    } else if (0 < n && n <= 21) {
+        out.append(digits, n);
+        out += '.';
+        out.append(digits + n, k - n);
+    } else if (-6 < n && n <= 0) {
+        out += "0.";
+        out.append(-n, '0');
+        out.append(digits, k);
+    } else {
+        out += digits[0];
+        if (k > 1) {
+            out += '.';
+            out.append(digits + 1, k - 1);
+        }
+        out += n - 1 < 0 ? "e-" : "e+";
+        out += std::to_string(std::abs(n - 1));
+    }
+}
+} // namespace NuoJs
@@ -0,0 +1,45 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_DECIMAL_H
+#define NUOJS_DECIMAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace NuoJs
+{
+// ScaledDecimal is the value of a NUMERIC or DECIMAL as an unscaled integer
+// and the number of digits after the decimal point: 12.50 is 1250, scale 2.
+struct ScaledDecimal
+{
+    int64_t unscaled = 0;
+    uint32_t scale = 0;
+    // the number of significant digits of the unscaled value
+    uint32_t digits = 0;
+};
+
+// parseDecimal parses the text form of a decimal, with an optional exponent,
+// natively and without V8. It returns false if the text is not a decimal or
+// the unscaled value does not fit in 64 bits.
+bool parseDecimal(const char* s, size_t length, ScaledDecimal& decimal);
+
+// toNumber converts a decimal to the nearest double, which is the same
+// double the ES Number parser would return. It returns false if the double
+// would not convert back to the same decimal, that is if the decimal has
+// more than 15 significant digits.
+bool toNumber(const ScaledDecimal& decimal, double& number);
+
+// appendDecimal appends the text of an unscaled value and a scale to out,
+// 1250 with scale 2 being "12.50".
+void appendDecimal(int64_t unscaled, uint32_t scale, std::string& out);
+
+// appendNumber appends the text of a finite double to out, as the ES Number
+// toString gives it: 100000 rather than 1e+05, and 1e-7 rather than 1e-07.
+void appendNumber(double value, std::string& out);
+} // namespace NuoJs
+
+#endif
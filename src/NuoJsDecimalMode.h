@@ -0,0 +1,21 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_DECIMALMODE_H
+#define NUOJS_DECIMALMODE_H
+
+namespace NuoJs
+{
+// DecimalMode controls how NUMERIC and DECIMAL values are returned; as
+// strings, as Numbers when the value survives the conversion, or as a pair
+// of the unscaled value as a BigInt and the scale.
+enum DecimalMode {
+    DECIMALS_AS_STRING, // default
+    DECIMALS_AS_NUMBER,
+    DECIMALS_AS_BIGINT
+};
+}
+
+#endif
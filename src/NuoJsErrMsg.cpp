@@ -35,6 +35,20 @@ static const char* errMsg[] = {
     "{\"Context\": \"statement is not open\"}",                                    // errNoStatement
     "{\"Context\": \"rollback failed\", \"Exception\": %s}",                     // errRollback
     "{\"Context\": \"commit failed\", \"Exception\": %s}",                       // errCommit
+    "{\"Context\": \"statement is executing or has an open result set\"}",       // errStatementBusy
+    "{\"Context\": \"LOB is closed along with its result set\"}",                // errLobClosed
+    "{\"Context\": \"LOB is already being read\"}",                              // errLobBusy
+    "{\"Context\": \"result set is already being read\"}",                       // errResultSetBusy
+    "{\"Context\": \"cannot write export file\", \"Error\": \"%s\"}",            // errExportFile
+    "{\"Context\": \"failed to export result set rows\", \"Exception\": %s}",   // errExport
+    "{\"Context\": \"cannot read load file\", \"Error\": \"%s\"}",              // errLoadFile
+    "{\"Context\": \"malformed record in load file\", \"Line\": %d}",           // errLoadRecord
+    "{\"Context\": \"failed to load rows\", \"Exception\": %s}",               // errLoad
+    "{\"Context\": \"rows exceed the maximum length of a string\"}",           // errJsonTooLong
+    "{\"Context\": \"rows exceed maxBufferedBytes\", \"Limit\": %llu}",          // errMaxBufferedBytes
+    "{\"Context\": \"result set is closed\"}",                                  // errResultSetClosed
+    "{\"Context\": \"column name in load file is not an identifier\", \"Column\": %d}",  // errLoadColumn
+    "{\"Context\": \"rows exceed the maximum length of a Buffer\"}",           // errArrowTooLong
 };
 
 // See `format`:
@@ -33,6 +33,20 @@ enum ErrMsgType {
     errNoStatement = 18,
     errRollback = 19,
     errCommit = 20,
+    errStatementBusy = 21,
+    errLobClosed = 22,
+    errLobBusy = 23,
+    errResultSetBusy = 24,
+    errExportFile = 25,
+    errExport = 26,
+    errLoadFile = 27,
+    errLoadRecord = 28,
+    errLoad = 29,
+    errJsonTooLong = 30,
+    errMaxBufferedBytes = 31,
+    errResultSetClosed = 32,
+    errLoadColumn = 33,
+    errArrowTooLong = 34,
 
     // New ones should be added here
 
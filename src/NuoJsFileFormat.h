@@ -0,0 +1,39 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_FILEFORMAT_H
+#define NUOJS_FILEFORMAT_H
+
+#include <string>
+
+namespace NuoJs
+{
+// FileFormat is the layout of the files rows are exported to and loaded
+// from; CSV with a header row, one JSON object per line, or an Arrow IPC
+// stream, which is only exported.
+enum FileFormat {
+    FILE_CSV, // default
+    FILE_NDJSON,
+    FILE_ARROW
+};
+
+// toFileFormat maps the name of a format, "csv", "ndjson" or "arrow", to the
+// format, returning false for any other name.
+inline bool toFileFormat(const std::string& name, FileFormat& format)
+{
+    if (name == "csv") {
+        format = FILE_CSV;
+    } else if (name == "ndjson") {
+        format = FILE_NDJSON;
+    } else if (name == "arrow") {
+        format = FILE_ARROW;
+    } else {
+        return false;
+    }
+    return true;
+}
+}
+
+#endif
@@ -61,6 +61,26 @@ uint32_t getJsonUint(Local<Object> object, std::string key, uint32_t defaultValu
     return value;
 }
 
+uint64_t getJsonUint64(Local<Object> object, std::string key, uint64_t defaultValue)
+{
+    // 2^53 - 1, Number.MAX_SAFE_INTEGER
+    const double maxSafeInteger = 9007199254740991.0;
+
+    Nan::EscapableHandleScope scope;
+    uint64_t value = defaultValue;
+    MaybeLocal<Value> maybe = Nan::Get(object, Nan::New(key).ToLocalChecked());
+    Local<Value> local;
+    if (maybe.ToLocal(&local) && !local->IsNullOrUndefined()) {
+        double number = local->IsNumber() ? Nan::To<double>(local).FromJust() : -1;
+        if (!(number >= 0 && number <= maxSafeInteger) || number != (double)(uint64_t)number) {
+            std::string message = ErrMsg::get(ErrMsgType::errInvalidPropertyType, key.c_str());
+            throw std::runtime_error(message);
+        }
+        value = (uint64_t)number;
+    }
+    return value;
+}
+
 bool getJsonBoolean(Local<Object> object, std::string key, bool defaultValue)
 {
     Nan::EscapableHandleScope scope;
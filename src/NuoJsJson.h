@@ -26,6 +26,12 @@ int32_t getJsonInt(Local<Object> object, std::string key, int32_t defaultValue);
 // but the type is not a uint, the method will throw a std::exception.
 uint32_t getJsonUint(Local<Object> object, std::string key, uint32_t defaultValue);
 
+// getJsonUint64 gets a property identified by key from the object. If the
+// key is not present, the default value is returned. If the key is present
+// but is not a safe integer of at least zero, the method will throw a
+// std::exception.
+uint64_t getJsonUint64(Local<Object> object, std::string key, uint64_t defaultValue);
+
 // getJsonBoolean gets a property identified by key from the object. If the
 // key is not present, the default value is returned. If the key is present
 // but the type is not a bool, the method will throw a std::exception.
@@ -0,0 +1,197 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsLob.h"
+#include "NuoJsErrMsg.h"
+
+#include "NuoJsData.h"
+
+#include <cstdlib>
+
+namespace NuoJs
+{
+
+Nan::Persistent<Function> Lob::constructor;
+
+// chunks are read 64 KiB at a time unless the caller asks otherwise
+static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+Lob::Lob()
+    : Nan::ObjectWrap()
+{
+    TRACE("Lob::Lob");
+}
+
+/* virtual */
+Lob::~Lob()
+{
+    TRACE("Lob::~Lob");
+}
+
+/* static */
+NAN_MODULE_INIT(Lob::init)
+{
+    TRACE("Lob::init");
+    Nan::HandleScope scope;
+
+    // prepare constructor template...
+    Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(Lob::newInstance);
+    tpl->SetClassName(Nan::New("Lob").ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+    // prototypes...
+    Nan::SetPrototypeMethod(tpl, "read", read);
+
+    constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
+    Nan::Set(target, Nan::New<v8::String>("Lob").ToLocalChecked(),
+             Nan::GetFunction(tpl).ToLocalChecked());
+}
+
+/* static */
+NAN_METHOD(Lob::newInstance)
+{
+    TRACE("Lob::newInstance");
+    Nan::HandleScope scope;
+    if (info.IsConstructCall()) {
+        Lob* obj = new Lob();
+        obj->Wrap(info.This());
+        info.GetReturnValue().Set(info.This());
+    } else {
+        Local<Function> cons = Nan::New<Function>(constructor);
+        info.GetReturnValue().Set(Nan::NewInstance(cons).ToLocalChecked());
+    }
+}
+
+/* static */
+Local<Object> Lob::createFrom(std::shared_ptr<Cursor> cursor, NuoDB::Clob* lob)
+{
+    TRACE("Lob::createFrom");
+    Nan::EscapableHandleScope scope;
+    Local<Function> cons = Nan::New<Function>(Lob::constructor);
+    Local<Object> obj = Nan::NewInstance(cons).ToLocalChecked();
+    Lob* self = Nan::ObjectWrap::Unwrap<Lob>(obj);
+    self->cursor = cursor;
+    self->lob = lob;
+    return scope.Escape(obj);
+}
+
+class LobReadWorker : public Nan::AsyncWorker
+{
+public:
+    LobReadWorker(Nan::Callback* callback, Lob* self, size_t size, std::string error)
+        : Nan::AsyncWorker(callback), self(self), size(size), error(error)
+    {
+        TRACE("LobReadWorker::LobReadWorker");
+        data = manager.getData();
+        COUNT_ADD(data, LOBREAD_CNT);
+    }
+
+    virtual ~LobReadWorker()
+    {
+        TRACE("LobReadWorker::~LobReadWorker");
+        COUNT_SUB(data, LOBREAD_CNT);
+        // workers are deleted on the main event loop thread
+        if (error.empty()) {
+            self->reading = false;
+        }
+        free(buffer);
+    }
+
+    virtual void Execute()
+    {
+        TRACE("LobReadWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(LOBREAD_QUE, QUE, data)
+            return;
+        }
+        if (self->ended) {
+            end = true;
+            return;
+        }
+        try {
+          ADD_COUNT(LOBREAD_DO, DO, data)
+          SUBTRACT_COUNT(LOBREAD_DO, DO, data)
+          buffer = static_cast<char*>(malloc(size));
+          if (buffer == nullptr) {
+              throw std::bad_alloc();
+          }
+          count = self->cursor->readLob(self->lob, self->offset, size, buffer, end);
+        } catch (std::exception& e) {
+            SetErrorMessage(e.what());
+            SUBTRACT_COUNT(LOBREAD_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("LobReadWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        self->offset += count;
+        self->ended = end;
+        Local<Value> chunk = Nan::Null();
+        if (count > 0) {
+            // the buffer is freed by Node when it is collected
+            chunk = Nan::NewBuffer(buffer, count).ToLocalChecked();
+            buffer = nullptr;
+        }
+        Local<Value> argv[] = {
+            Nan::Null(),
+            chunk
+        };
+        SUBTRACT_COUNT(LOBREAD_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+private:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    Lob* self;
+    size_t size;
+    std::string error;
+    char* buffer = nullptr;
+    size_t count = 0;
+    bool end = false;
+};
+
+/* static */
+NAN_METHOD(Lob::read)
+{
+    TRACE("Lob::read");
+    Nan::HandleScope scope;
+
+    Lob* self = Nan::ObjectWrap::Unwrap<Lob>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    // chunk size (optional)
+    auto infoIdx = 0;
+    size_t size = DEFAULT_CHUNK_SIZE;
+    if (info.Length() > 1 && info[infoIdx]->IsUint32()) {
+        size = Nan::To<uint32_t>(info[infoIdx++]).FromJust();
+    }
+    if (size == 0) {
+        size = DEFAULT_CHUNK_SIZE;
+    }
+
+    std::string error;
+    if (self->reading) {
+        error = ErrMsg::get(ErrMsgType::errLobBusy);
+    } else {
+        self->reading = true;
+    }
+
+    Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
+
+    LobReadWorker* worker = new LobReadWorker(callback, self, size, error);
+    worker->SaveToPersistent("nuodb:Lob", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(LOBREAD_QUE, QUE, worker->data)
+}
+} // namespace NuoJs
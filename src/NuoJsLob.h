@@ -0,0 +1,51 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_LOB_H
+#define NUOJS_LOB_H
+
+#include "NuoJsAddon.h"
+#include "NuoJsCursor.h"
+
+#include <memory>
+
+namespace NuoJs
+{
+// Lob is a character LOB too long to be returned as a string, read in
+// chunks from a worker thread. The LOB is owned by the cursor it was
+// fetched by, and can be read until the result set is closed.
+class Lob : public Nan::ObjectWrap
+{
+public:
+    Lob();
+
+    virtual ~Lob();
+
+    static NAN_MODULE_INIT(init);
+
+    static NAN_METHOD(newInstance);
+
+    static Local<Object> createFrom(std::shared_ptr<Cursor> cursor, NuoDB::Clob* lob);
+
+    static Nan::Persistent<Function> constructor;
+
+private:
+
+    static NAN_METHOD(read);
+    friend class LobReadWorker;
+
+    // set while a read is queued or running
+    bool reading = false;
+
+    // set once the LOB has been read to the end
+    bool ended = false;
+
+    size_t offset = 0;
+    std::shared_ptr<Cursor> cursor;
+    NuoDB::Clob* lob = nullptr;
+};
+} // namespace NuoJs
+
+#endif
@@ -7,12 +7,17 @@
 #include "NuoJsErrMsg.h"
 #include "NuoJsJson.h"
 
+#include <cstdint>
 #include <stdio.h>
 #include <iostream>
 
 namespace NuoJs
 {
 const uint32_t CONSISTENT_READ = 7;
+const uint32_t PREFETCH_MAX_BYTES = 16 * 1024 * 1024;
+
+uint32_t Options::Default_MaxRows = 0;
+uint64_t Options::Default_MaxBufferedBytes = 0;
 
 Options::Options()
     // defaults for all statement options
@@ -21,24 +26,49 @@ Options::Options()
       isolationLevel(CONSISTENT_READ),
       autoCommit(true),
       readOnly(false),
-      queryTimeout(0)
+      queryTimeout(0),
+      prefetchDepth(0),
+      prefetchMaxBytes(PREFETCH_MAX_BYTES),
+      bigInt(false),
+      lobStreamThreshold(0),
+      decimalMode(DECIMALS_AS_STRING),
+      maxRows(Default_MaxRows),
+      maxBufferedBytes(Default_MaxBufferedBytes)
 {}
 
 Options::Options(const Options& options)
     : rowMode(options.rowMode),
       fetchSize(options.fetchSize),
+      isolationLevel(options.isolationLevel),
       autoCommit(options.autoCommit),
       readOnly(options.readOnly),
-      queryTimeout(options.queryTimeout)
+      queryTimeout(options.queryTimeout),
+      prefetchDepth(options.prefetchDepth),
+      prefetchMaxBytes(options.prefetchMaxBytes),
+      bigInt(options.bigInt),
+      lobStreamThreshold(options.lobStreamThreshold),
+      decimalMode(options.decimalMode),
+      maxRows(options.maxRows),
+      maxBufferedBytes(options.maxBufferedBytes),
+      defaults(options.defaults)
 {}
 
 Options& Options::operator=(const Options& options)
 {
     this->rowMode = options.rowMode;
     this->fetchSize = options.fetchSize;
+    this->isolationLevel = options.isolationLevel;
     this->autoCommit = options.autoCommit;
     this->readOnly = options.readOnly;
     this->queryTimeout = options.queryTimeout;
+    this->prefetchDepth = options.prefetchDepth;
+    this->prefetchMaxBytes = options.prefetchMaxBytes;
+    this->bigInt = options.bigInt;
+    this->lobStreamThreshold = options.lobStreamThreshold;
+    this->decimalMode = options.decimalMode;
+    this->maxRows = options.maxRows;
+    this->maxBufferedBytes = options.maxBufferedBytes;
+    this->defaults = options.defaults;
     return *this;
 }
 
@@ -128,9 +158,123 @@ void Options::setQueryTimeout(uint32_t v)
     }
 }
 
+uint32_t Options::getPrefetchDepth() const
+{
+    return prefetchDepth;
+}
+
+void Options::setPrefetchDepth(uint32_t v)
+{
+    if (v != prefetchDepth) {
+      setNonDefault(Option::prefetchdepth);
+      prefetchDepth = v;
+    }
+}
+
+uint32_t Options::getPrefetchMaxBytes() const
+{
+    return prefetchMaxBytes;
+}
+
+void Options::setPrefetchMaxBytes(uint32_t v)
+{
+    if (v != prefetchMaxBytes) {
+      setNonDefault(Option::prefetchmaxbytes);
+      prefetchMaxBytes = v;
+    }
+}
+
+bool Options::getBigInt() const
+{
+    return bigInt;
+}
+
+void Options::setBigInt(bool v)
+{
+    if (v != bigInt) {
+      setNonDefault(Option::bigint);
+      bigInt = v;
+    }
+}
+
+uint32_t Options::getLobStreamThreshold() const
+{
+    return lobStreamThreshold;
+}
+
+void Options::setLobStreamThreshold(uint32_t v)
+{
+    if (v != lobStreamThreshold) {
+      setNonDefault(Option::lobstreamthreshold);
+      lobStreamThreshold = v;
+    }
+}
+
+DecimalMode Options::getDecimalMode() const
+{
+    return decimalMode;
+}
+
+void Options::setDecimalMode(DecimalMode v)
+{
+    if (v != decimalMode) {
+      setNonDefault(Option::decimalmode);
+      decimalMode = v;
+    }
+}
+
+uint32_t Options::getMaxRows() const
+{
+    return maxRows;
+}
+
+void Options::setMaxRows(uint32_t v)
+{
+    if (v != maxRows) {
+      setNonDefault(Option::maxrows);
+      maxRows = v;
+    }
+}
+
+uint64_t Options::getMaxBufferedBytes() const
+{
+    return maxBufferedBytes;
+}
+
+void Options::setMaxBufferedBytes(uint64_t v)
+{
+    if (v != maxBufferedBytes) {
+      setNonDefault(Option::maxbufferedbytes);
+      maxBufferedBytes = v;
+    }
+}
+
 RowMode toRowMode(uint32_t value)
 {
-    return (value == ROWS_AS_OBJECT) ? ROWS_AS_OBJECT : ROWS_AS_ARRAY;
+    switch (value) {
+        case ROWS_AS_OBJECT:
+            return ROWS_AS_OBJECT;
+        case ROWS_AS_COLUMNS:
+            return ROWS_AS_COLUMNS;
+        case ROWS_AS_JSON:
+            return ROWS_AS_JSON;
+        case ROWS_AS_LAZY_OBJECT:
+            return ROWS_AS_LAZY_OBJECT;
+        default:
+            return ROWS_AS_ARRAY;
+    }
+}
+
+DecimalMode toDecimalMode(uint32_t value)
+{
+    switch (value) {
+        case DECIMALS_AS_NUMBER:
+            return DECIMALS_AS_NUMBER;
+        case DECIMALS_AS_BIGINT:
+            return DECIMALS_AS_BIGINT;
+        default:
+            return DECIMALS_AS_STRING;
+    }
 }
 
 void getJsonOptions(Local<Object> object, Options& options)
@@ -141,6 +285,18 @@ void getJsonOptions(Local<Object> object, Options& options)
     options.setAutoCommit(getJsonBoolean(object, "autoCommit", options.getAutoCommit()));
     options.setReadOnly(getJsonBoolean(object, "readOnly", options.getReadOnly()));
     options.setQueryTimeout(getJsonUint(object, "queryTimeout", options.getQueryTimeout()));
+    options.setPrefetchDepth(getJsonUint(object, "prefetchDepth", options.getPrefetchDepth()));
+    options.setPrefetchMaxBytes(getJsonUint(object, "prefetchMaxBytes", options.getPrefetchMaxBytes()));
+    options.setBigInt(getJsonBoolean(object, "bigint", options.getBigInt()));
+    options.setLobStreamThreshold(getJsonUint(object, "lobStreamThreshold", options.getLobStreamThreshold()));
+    options.setDecimalMode(toDecimalMode(getJsonUint(object, "decimalMode", options.getDecimalMode())));
+    options.setMaxRows(getJsonUint(object, "maxRows", options.getMaxRows()));
+    if (options.getMaxRows() > INT32_MAX) {
+        // the database takes the limit as an int
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidPropertyValue, "maxRows");
+        throw std::runtime_error(message);
+    }
+    options.setMaxBufferedBytes(getJsonUint64(object, "maxBufferedBytes", options.getMaxBufferedBytes()));
 }
 
 void Options::setNonDefault(Options::Option bit) 
@@ -8,6 +8,7 @@
 
 #include "NuoJsAddon.h"
 #include "NuoJsRowMode.h"
+#include "NuoJsDecimalMode.h"
 
 namespace NuoJs
 {
@@ -22,9 +23,22 @@ public:
 	    isolationlevel = 3,
 	    autocommit = 4,
 	    readonly = 5,
-	    querytimeout = 6
+	    querytimeout = 6,
+	    prefetchdepth = 7,
+	    prefetchmaxbytes = 8,
+	    bigint = 9,
+	    lobstreamthreshold = 10,
+	    decimalmode = 11,
+	    maxrows = 12,
+	    maxbufferedbytes = 13
     };
 
+    // the driver-wide defaults of maxRows and maxBufferedBytes, set from the
+    // NUODB_NODE_MAX_ROWS and NUODB_NODE_MAX_BUFFERED_BYTES environment
+    // variables
+    static uint32_t Default_MaxRows;
+    static uint64_t Default_MaxBufferedBytes;
+
     // Options constructor sets reasonable defaults.
     Options();
     Options(const Options& options);
@@ -50,6 +64,38 @@ public:
     uint32_t getQueryTimeout() const;
     void setQueryTimeout(uint32_t);
 
+    // prefetchDepth is the number of batches getRows reads ahead in the
+    // background, zero disables read-ahead
+    uint32_t getPrefetchDepth() const;
+    void setPrefetchDepth(uint32_t);
+
+    // prefetchMaxBytes caps the memory held by rows read ahead
+    uint32_t getPrefetchMaxBytes() const;
+    void setPrefetchMaxBytes(uint32_t);
+
+    // bigInt returns BIGINT columns as ES BigInt values rather than as
+    // numbers, or strings when outside the safe integer range
+    bool getBigInt() const;
+    void setBigInt(bool);
+
+    // lobStreamThreshold is the length above which character LOBs are
+    // returned as a LOB to be read in chunks, zero returns them as strings
+    uint32_t getLobStreamThreshold() const;
+    void setLobStreamThreshold(uint32_t);
+
+    DecimalMode getDecimalMode() const;
+    void setDecimalMode(DecimalMode);
+
+    // maxRows limits the rows the database returns for a query, zero
+    // returns all rows
+    uint32_t getMaxRows() const;
+    void setMaxRows(uint32_t);
+
+    // maxBufferedBytes caps the memory a single getRows call may buffer,
+    // zero leaves it unbounded
+    uint64_t getMaxBufferedBytes() const;
+    void setMaxBufferedBytes(uint64_t);
+
     void setNonDefault(Option);
     void unsetNonDefault(Option);
     bool isNonDefault(Option);
@@ -61,6 +107,13 @@ private:
     bool autoCommit;
     bool readOnly;
     uint32_t queryTimeout;
+    uint32_t prefetchDepth;
+    uint32_t prefetchMaxBytes;
+    bool bigInt;
+    uint32_t lobStreamThreshold;
+    DecimalMode decimalMode;
+    uint32_t maxRows;
+    uint64_t maxBufferedBytes;
     int defaults = 0;
 };
 
@@ -9,9 +9,19 @@
 #include "NuoJsTypes.h"
 #include "NuoJsNan.h"
 #include "NuoJsNanDate.h"
+#include "NuoJsLob.h"
+#include "NuoJsJson.h"
+#include "NuoJsArrow.h"
 #include "NuoDB.h"
 #include <iostream>
 
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <unordered_map>
+
 #include "NuoJsData.h"
 
 
@@ -22,7 +32,7 @@ namespace NuoJs
 Nan::Persistent<Function> ResultSet::constructor;
 
 ResultSet::ResultSet()
-    : Nan::ObjectWrap(), statement(nullptr), result(nullptr)
+    : Nan::ObjectWrap(), statement(nullptr)
 {
     TRACE("ResultSet::ResultSet");
 }
@@ -46,6 +56,10 @@ NAN_MODULE_INIT(ResultSet::init)
 
     // prototypes...
     Nan::SetPrototypeMethod(tpl, "getRows", getRows);
+    Nan::SetPrototypeMethod(tpl, "getBufferedRows", getBufferedRows);
+    Nan::SetPrototypeMethod(tpl, "getRowMode", getRowMode);
+    Nan::SetPrototypeMethod(tpl, "exportTo", exportTo);
+    Nan::SetPrototypeMethod(tpl, "getArrow", getArrow);
     Nan::SetPrototypeMethod(tpl, "close", close);
 
     constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
@@ -69,7 +83,9 @@ NAN_METHOD(ResultSet::newInstance)
 }
 
 /* static */
-Local<Object> ResultSet::createFrom(class NuoDB::Statement* statement, Options options)
+Local<Object> ResultSet::createFrom(class NuoDB::PreparedStatement* statement, Options options,
+                                    std::shared_ptr<StatementCache> statementCache, std::string sql,
+                                    std::unique_ptr<Cursor> cursor)
 {
     TRACE("ResultSet::createFrom");
     Nan::EscapableHandleScope scope;
@@ -78,14 +94,36 @@ Local<Object> ResultSet::createFrom(class NuoDB::Statement* statement, Options o
     ResultSet* self = Nan::ObjectWrap::Unwrap<ResultSet>(obj);
     self->statement = statement;
     self->options = options;
+    self->statementCache = statementCache;
+    self->sql = sql;
+    self->cursor = std::move(cursor);
+    return scope.Escape(obj);
+}
+
+/* static */
+Local<Object> ResultSet::createFrom(std::shared_ptr<NuoDB::PreparedStatement> statement, Options options,
+                                    std::unique_ptr<Cursor> cursor)
+{
+    TRACE("ResultSet::createFrom");
+    Nan::EscapableHandleScope scope;
+    Local<Function> cons = Nan::New<Function>(ResultSet::constructor);
+    Local<Object> obj = Nan::NewInstance(cons).ToLocalChecked();
+    ResultSet* self = Nan::ObjectWrap::Unwrap<ResultSet>(obj);
+    self->statement = statement.get();
+    self->sharedStatement = statement;
+    self->options = options;
+    self->cursor = std::move(cursor);
     return scope.Escape(obj);
 }
 
 class ResultSetCloseWorker : public Nan::AsyncWorker
 {
 public:
-    ResultSetCloseWorker(Nan::Callback* callback, ResultSet* self)
-        : Nan::AsyncWorker(callback), self(self)
+    // The cursor has been taken from the result set on the main thread; only
+    // the first close releases the cursor and the statement.
+    ResultSetCloseWorker(Nan::Callback* callback, ResultSet* self, std::shared_ptr<Cursor> cursor, bool release,
+                         std::string error)
+        : Nan::AsyncWorker(callback), self(self), cursor(std::move(cursor)), release(release), error(error)
     {
         TRACE("ResultSetCloseWorker::ResultSetCloseWorker");
         data = manager.getData();
@@ -106,10 +144,17 @@ public:
     virtual void Execute()
     {
         TRACE("ResultSetCloseWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(RESULTSETCLOSE_QUE, QUE, data)
+            return;
+        }
         try {
           ADD_COUNT(RESULTSETCLOSE_DO, DO, data)
           SUBTRACT_COUNT(RESULTSETCLOSE_DO, DO, data)
-          self->doClose();
+          if (release) {
+              self->doClose(cursor);
+          }
         } catch (std::exception& e) {
             std::string message = ErrMsg::get(ErrMsgType::errFailedCloseResultSet, e.what());
             SetErrorMessage(message.c_str());
@@ -137,6 +182,9 @@ public:
 private:
     NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
     ResultSet* self = nullptr;
+    std::shared_ptr<Cursor> cursor;
+    bool release;
+    std::string error;
 };
 
 /* static */
@@ -153,46 +201,89 @@ NAN_METHOD(ResultSet::close)
     }
     Nan::Callback* callback = new Nan::Callback(info[0].As<Function>());
 
-    ResultSetCloseWorker* worker = new ResultSetCloseWorker(callback, self);
+    // the cursor must not be released under a worker still reading it; once
+    // closed, the main thread no longer touches the cursor or the statement
+    std::string error;
+    std::shared_ptr<Cursor> cursor;
+    bool release = false;
+    if (self->fetching) {
+        error = ErrMsg::get(ErrMsgType::errResultSetBusy);
+    } else if (!self->closed) {
+        self->closed = true;
+        cursor = std::move(self->cursor);
+        release = true;
+    }
+
+    ResultSetCloseWorker* worker = new ResultSetCloseWorker(callback, self, cursor, release, error);
     worker->SaveToPersistent("nuodb:ResultSet", info.This());
     Nan::AsyncQueueWorker(worker);
     ADD_COUNT(RESULTSETCLOSE_QUE, QUE, worker->data)
 }
 
-void ResultSet::doClose()
+void ResultSet::doClose(std::shared_ptr<Cursor>& cursor)
 {
     TRACE("ResultSet::doClose");
-    if (result != nullptr) {
-        if (this->hasBeenClosed) {
-          throw std::runtime_error("Detected Double Close");
-        } else {
-          result->close();
-          this->hasBeenClosed = true;
-          result = nullptr;
-          if (statement != nullptr) {
-            statement->close();
-            statement = nullptr;
-          }
+    if (cursor != nullptr) {
+        cursor->close();
+        this->hasBeenClosed = true;
+        cursor.reset();
+    }
+    if (statement != nullptr) {
+        releaseStatement();
+    }
+}
+
+void ResultSet::releaseStatement()
+{
+    TRACE("ResultSet::releaseStatement");
+    // rows were never requested, the pending result must not be left
+    // open on a statement that will be reused
+    if (!hasBeenClosed && (statementCache || sharedStatement)) {
+        hasBeenClosed = true;
+        try {
+            NuoDB::ResultSet* pending = statement->getResultSet();
+            if (pending != nullptr) {
+                pending->close();
+            }
+        } catch (NuoDB::SQLException& e) {
+            if (statementCache) {
+                statementCache->discard(statement);
+                statement = nullptr;
+                return;
+            }
         }
     }
+    if (statementCache) {
+        statementCache->release(sql, statement);
+    } else if (sharedStatement) {
+        sharedStatement.reset();
+    } else {
+        statement->close();
+    }
+    statement = nullptr;
 }
 
 class GetRowsWorker : public Nan::AsyncWorker
 {
 public:
-    GetRowsWorker(Nan::Callback* callback, ResultSet* self, size_t count)
-        : Nan::AsyncWorker(callback), self(self), count(count)
+    GetRowsWorker(Nan::Callback* callback, ResultSet* self, size_t count, bool continued, std::string error)
+        : Nan::AsyncWorker(callback), self(self), count(count), continued(continued), error(error)
     {
         TRACE("GetRowsWorker::GetRowsWorker");
         data = manager.getData();
         COUNT_ADD(data, GETROWS_CNT);
+        if (error.empty()) {
+            self->fetching = true;
+        }
     }
 
     virtual ~GetRowsWorker()
     {
         TRACE("GetRowsWorker::~GetRowsWorker");
         COUNT_SUB(data, GETROWS_CNT);
-
+        if (error.empty()) {
+            self->fetching = false;
+        }
     }
 
     /**
@@ -203,10 +294,29 @@ public:
     virtual void Execute()
     {
         TRACE("GetRowsWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(GETROWS_QUE, QUE, data)
+            return;
+        }
         try {
           ADD_COUNT(GETROWS_DO, DO, data)
           SUBTRACT_COUNT(GETROWS_DO, DO, data)
-          self->doGetRows(count);
+          self->doGetRows(count, continued);
+          if (self->options.getRowMode() == RowMode::ROWS_AS_COLUMNS) {
+              // the typed arrays are filled here, off the main thread
+              RowBatches batches = self->cursor->take(count);
+              columnar.reset(new ColumnarRows(std::move(batches), self->cursor->getColumns(),
+                                              self->options.getDecimalMode()));
+          } else if (self->options.getRowMode() == RowMode::ROWS_AS_JSON) {
+              // as is the whole JSON text, leaving a single string to create
+              json = self->getRowsAsJson(count);
+              isJson = true;
+              if (json.size() > (size_t)String::kMaxLength) {
+                  std::string message = ErrMsg::get(ErrMsgType::errJsonTooLong);
+                  throw std::runtime_error(message);
+              }
+          }
         } catch (std::exception& e) {
             std::string message = ErrMsg::get(ErrMsgType::errGetRows, e.what());
             SetErrorMessage(message.c_str());
@@ -222,12 +332,21 @@ public:
     {
         TRACE("GetRowsWorker::HandleOKCallback");
         Nan::HandleScope scope;
-        Local<Value> rows = self->getRowsAsJsValue();
+        Local<Value> rows;
+        if (isJson) {
+            rows = Nan::New<String>(json.data(), (int)json.size()).ToLocalChecked();
+        } else if (columnar) {
+            rows = self->getColumnsAsJsValue(*columnar);
+        } else {
+            rows = self->getRowsAsJsValue(count);
+        }
         Local<Value> argv[] = {
             Nan::Null(),
             rows
         };
         SUBTRACT_COUNT(GETROWS_QUE, QUE, data)
+        self->fetching = false;
+        self->startPrefetch(count);
         callback->Call(2, argv, async_resource);
 
     }
@@ -238,18 +357,26 @@ private:
     NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
     ResultSet* self;
     size_t count;
+    bool continued;
+    std::string error;
+    std::unique_ptr<ColumnarRows> columnar;
+    std::string json;
+    bool isJson = false;
 };
 
 /**
  * getRows is used to retrieve rows from the result set.
  *
- * getRows can have two or fewer parameters.
+ * getRows can have three or fewer parameters.
  *
  * (optional) Number :      an integer indicating the count of rows to be
  *                          returned. If unspecified, the method returns all
  *                          rows. This must be the first parameter.
  *                          Negative zero (0) is a sentinel value that means
  *                          "all".
+ * (optional) Boolean :     true when the call continues a request of the
+ *                          application made in several batches, whose rows
+ *                          together are bounded by maxBufferedBytes.
  * (optional) Function :    an error-first callback if this method is called
  *                          asynchronously; if omitted, then a promise is
  *                          returned.
@@ -267,6 +394,10 @@ NAN_METHOD(ResultSet::getRows)
     if (infoLen > 0 && info[infoIdx]->IsInt32()) {
         rowsToRead = (size_t)toInt32(info[infoIdx++]);
     }
+    bool continued = false;
+    if (infoLen > infoIdx && info[infoIdx]->IsBoolean()) {
+        continued = Nan::To<bool>(info[infoIdx++]).FromJust();
+    }
 
     if (!info[infoIdx]->IsFunction()) {
         std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 1);
@@ -275,60 +406,544 @@ NAN_METHOD(ResultSet::getRows)
     }
     Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
 
-    GetRowsWorker* worker = new GetRowsWorker(callback, self, rowsToRead);
+    std::string error;
+    if (self->closed) {
+        error = ErrMsg::get(ErrMsgType::errResultSetClosed);
+    }
+
+    GetRowsWorker* worker = new GetRowsWorker(callback, self, rowsToRead, continued, error);
     worker->SaveToPersistent("nuodb:ResultSet", info.This());
     Nan::AsyncQueueWorker(worker);
     ADD_COUNT(GETROWS_QUE, QUE, worker->data)
 }
 
+NAN_METHOD(ResultSet::getBufferedRows)
+{
+    TRACE("ResultSet::getBufferedRows");
+    Nan::HandleScope scope;
+
+    ResultSet* self = Nan::ObjectWrap::Unwrap<ResultSet>(info.This());
+
+    size_t rowsToRead = 0;
+    if (info.Length() > 0 && info[0]->IsInt32()) {
+        rowsToRead = (size_t)toInt32(info[0]);
+    }
+    bool continued = info.Length() > 1 && info[1]->IsTrue();
+
+    // JSON text is always written by a worker, off the main thread
+    if (self->fetching || self->closed || self->cursor == nullptr || !self->cursor->hasRows(rowsToRead) ||
+        self->options.getRowMode() == RowMode::ROWS_AS_JSON) {
+        info.GetReturnValue().Set(Nan::Undefined());
+        return;
+    }
+
+    // a request that has used up maxBufferedBytes is left to a worker to fail
+    size_t maxBytes = self->options.getMaxBufferedBytes();
+    if (maxBytes > 0 && self->getRequestBytes(continued) >= maxBytes) {
+        info.GetReturnValue().Set(Nan::Undefined());
+        return;
+    }
+    info.GetReturnValue().Set(self->getRowsAsJsValue(rowsToRead));
+    self->startPrefetch(rowsToRead);
+}
+
+// writeAll writes all of the text, retrying short and interrupted writes.
+static void writeAll(int fd, const std::string& text)
+{
+    size_t offset = 0;
+    while (offset < text.size()) {
+        ssize_t written = ::write(fd, text.data() + offset, text.size() - offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::string message = ErrMsg::get(ErrMsgType::errExportFile, strerror(errno));
+            throw std::runtime_error(message);
+        }
+        offset += (size_t)written;
+    }
+}
+
+class ExportWorker : public Nan::AsyncWorker
+{
+public:
+    ExportWorker(Nan::Callback* callback, ResultSet* self, std::string path, int fd,
+                 FileFormat format, std::string error)
+        : Nan::AsyncWorker(callback), self(self), path(path), fd(fd), format(format), error(error)
+    {
+        TRACE("ExportWorker::ExportWorker");
+        data = manager.getData();
+        COUNT_ADD(data, EXPORT_CNT);
+        if (error.empty()) {
+            self->fetching = true;
+        }
+    }
+
+    virtual ~ExportWorker()
+    {
+        TRACE("ExportWorker::~ExportWorker");
+        COUNT_SUB(data, EXPORT_CNT);
+        if (error.empty()) {
+            self->fetching = false;
+        }
+    }
+
+    /**
+     * Executes on the worker thread.
+     * It is unsafe to access JS engine data structures on worker threads.
+     * All input and output MUST occur on this->.
+     */
+    virtual void Execute()
+    {
+        TRACE("ExportWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(EXPORT_QUE, QUE, data)
+            return;
+        }
+        // a path is opened, and closed, here; a descriptor is left open
+        int target = fd;
+        try {
+          ADD_COUNT(EXPORT_DO, DO, data)
+          SUBTRACT_COUNT(EXPORT_DO, DO, data)
+          if (!path.empty()) {
+              target = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+              if (target < 0) {
+                  std::string message = ErrMsg::get(ErrMsgType::errExportFile, strerror(errno));
+                  throw std::runtime_error(message);
+              }
+          }
+          rows = self->doExportTo(format, [this, target](const std::string& text) {
+              writeAll(target, text);
+              bytes += text.size();
+          });
+          if (!path.empty()) {
+              int closed = ::close(target);
+              target = -1;
+              if (closed != 0) {
+                  std::string message = ErrMsg::get(ErrMsgType::errExportFile, strerror(errno));
+                  throw std::runtime_error(message);
+              }
+          }
+        } catch (std::exception& e) {
+            if (!path.empty() && target >= 0) {
+                ::close(target);
+            }
+            std::string message = ErrMsg::get(ErrMsgType::errExport, e.what());
+            SetErrorMessage(message.c_str());
+            SUBTRACT_COUNT(EXPORT_QUE, QUE, data)
+        }
+    }
+
+    /**
+     * Executes on the main event loop, so it's safe to access JS engine data
+     * structures. Called when async work is complete.
+     */
+    virtual void HandleOKCallback()
+    {
+        TRACE("ExportWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Object> result = Nan::New<Object>();
+        Nan::Set(result, Nan::New("rows").ToLocalChecked(), Nan::New<Number>((double)rows));
+        Nan::Set(result, Nan::New("bytes").ToLocalChecked(), Nan::New<Number>((double)bytes));
+        Local<Value> argv[] = {
+            Nan::Null(),
+            result
+        };
+        SUBTRACT_COUNT(EXPORT_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+private:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    ResultSet* self;
+    std::string path;
+    int fd;
+    FileFormat format;
+    std::string error;
+    size_t rows = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * exportTo writes the remaining rows of the result set to a file.
+ *
+ * exportTo can have three or fewer parameters.
+ *
+ * String | Number :        the path of a file, which is created or
+ *                          truncated, or an open file descriptor, which is
+ *                          left open.
+ * (optional) Object :      export options; format is 'csv' (the default),
+ *                          'ndjson' or 'arrow'.
+ * Function :               an error-first callback, called with the number
+ *                          of rows and bytes written.
+ */
+NAN_METHOD(ResultSet::exportTo)
+{
+    TRACE("ResultSet::exportTo");
+    Nan::HandleScope scope;
+
+    ResultSet* self = Nan::ObjectWrap::Unwrap<ResultSet>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    auto infoIdx = 0;
+    auto infoLen = info.Length();
+    std::string path;
+    int fd = -1;
+    if (info[infoIdx]->IsString()) {
+        Nan::Utf8String utf8str(info[infoIdx++]);
+        path = std::string(*utf8str, static_cast<size_t>(utf8str.length()));
+    } else if (info[infoIdx]->IsInt32() && toInt32(info[infoIdx]) >= 0) {
+        fd = toInt32(info[infoIdx++]);
+    }
+    if (path.empty() && fd < 0) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, 1);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+
+    FileFormat format = FILE_CSV;
+    if (infoLen > infoIdx + 1 && info[infoIdx]->IsObject()) {
+        try {
+            std::string name = getJsonString(info[infoIdx++].As<Object>(), "format", "csv");
+            if (!toFileFormat(name, format)) {
+                std::string message = ErrMsg::get(ErrMsgType::errInvalidPropertyValue, "format");
+                throw std::runtime_error(message);
+            }
+        } catch (std::exception& e) {
+            Nan::ThrowError(e.what());
+            return;
+        }
+    }
+
+    if (!info[infoIdx]->IsFunction()) {
+        std::string message = ErrMsg::get(ErrMsgType::errInvalidParamType, infoIdx + 1);
+        Nan::ThrowError(Nan::New<String>(message).ToLocalChecked());
+        return;
+    }
+
+    // rows taken by a concurrent getRows would be missing from the export
+    std::string error;
+    if (self->fetching) {
+        error = ErrMsg::get(ErrMsgType::errResultSetBusy);
+    } else if (self->closed) {
+        error = ErrMsg::get(ErrMsgType::errResultSetClosed);
+    }
+
+    Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
+
+    ExportWorker* worker = new ExportWorker(callback, self, path, fd, format, error);
+    worker->SaveToPersistent("nuodb:ResultSet", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(EXPORT_QUE, QUE, worker->data)
+}
+
+class ArrowWorker : public Nan::AsyncWorker
+{
+public:
+    ArrowWorker(Nan::Callback* callback, ResultSet* self, std::string error)
+        : Nan::AsyncWorker(callback), self(self), error(error)
+    {
+        TRACE("ArrowWorker::ArrowWorker");
+        data = manager.getData();
+        COUNT_ADD(data, ARROW_CNT);
+        if (error.empty()) {
+            self->fetching = true;
+        }
+    }
+
+    virtual ~ArrowWorker()
+    {
+        TRACE("ArrowWorker::~ArrowWorker");
+        COUNT_SUB(data, ARROW_CNT);
+        if (error.empty()) {
+            self->fetching = false;
+        }
+    }
+
+    /**
+     * Executes on the worker thread.
+     * It is unsafe to access JS engine data structures on worker threads.
+     * All input and output MUST occur on this->.
+     */
+    virtual void Execute()
+    {
+        TRACE("ArrowWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(ARROW_QUE, QUE, data)
+            return;
+        }
+        try {
+          ADD_COUNT(ARROW_DO, DO, data)
+          SUBTRACT_COUNT(ARROW_DO, DO, data)
+          stream.reset(new std::string());
+          std::string& out = *stream;
+          self->doExportTo(FILE_ARROW, [&out](const std::string& text) {
+              if (out.size() + text.size() > node::Buffer::kMaxLength) {
+                  std::string message = ErrMsg::get(ErrMsgType::errArrowTooLong);
+                  throw std::runtime_error(message);
+              }
+              out += text;
+          });
+        } catch (std::exception& e) {
+            std::string message = ErrMsg::get(ErrMsgType::errExport, e.what());
+            SetErrorMessage(message.c_str());
+            SUBTRACT_COUNT(ARROW_QUE, QUE, data)
+        }
+    }
+
+    /**
+     * Executes on the main event loop, so it's safe to access JS engine data
+     * structures. Called when async work is complete.
+     */
+    virtual void HandleOKCallback()
+    {
+        TRACE("ArrowWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        // the Buffer takes over the storage of the stream, without a copy
+        std::string* taken = stream.release();
+        Local<Value> argv[] = {
+            Nan::Null(),
+            Nan::NewBuffer(&(*taken)[0], taken->size(), freeStream, taken).ToLocalChecked()
+        };
+        SUBTRACT_COUNT(ARROW_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+private:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    ResultSet* self;
+    std::string error;
+    std::unique_ptr<std::string> stream;
+
+    static void freeStream(char* /*bytes*/, void* hint)
+    {
+        delete static_cast<std::string*>(hint);
+    }
+};
+
+/**
+ * getArrow returns the remaining rows of the result set as a Buffer holding
+ * an Arrow IPC stream.
+ *
+ * getArrow has one parameter.
+ *
+ * Function :               an error-first callback, called with the Buffer.
+ */
+NAN_METHOD(ResultSet::getArrow)
+{
+    TRACE("ResultSet::getArrow");
+    Nan::HandleScope scope;
+
+    ResultSet* self = Nan::ObjectWrap::Unwrap<ResultSet>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    std::string error;
+    if (self->fetching) {
+        error = ErrMsg::get(ErrMsgType::errResultSetBusy);
+    } else if (self->closed) {
+        error = ErrMsg::get(ErrMsgType::errResultSetClosed);
+    }
+
+    Nan::Callback* callback = new Nan::Callback(info[info.Length() - 1].As<Function>());
+
+    ArrowWorker* worker = new ArrowWorker(callback, self, error);
+    worker->SaveToPersistent("nuodb:ResultSet", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(ARROW_QUE, QUE, worker->data)
+}
+
+class PrefetchWorker : public Nan::AsyncWorker
+{
+public:
+    // There is no callback; the rows are left in the cursor buffer for the
+    // next getRows, as is any error.
+    PrefetchWorker(ResultSet* self, std::shared_ptr<Cursor> cursor, size_t count, size_t maxBytes)
+        : Nan::AsyncWorker(nullptr), self(self), cursor(cursor), count(count), maxBytes(maxBytes)
+    {
+        TRACE("PrefetchWorker::PrefetchWorker");
+        data = manager.getData();
+        COUNT_ADD(data, PREFETCH_CNT);
+    }
+
+    virtual ~PrefetchWorker()
+    {
+        TRACE("PrefetchWorker::~PrefetchWorker");
+        COUNT_SUB(data, PREFETCH_CNT);
+        self->prefetching = false;
+    }
+
+    virtual void Execute()
+    {
+        TRACE("PrefetchWorker::Execute");
+        try {
+          ADD_COUNT(PREFETCH_DO, DO, data)
+          SUBTRACT_COUNT(PREFETCH_DO, DO, data)
+          cursor->fetch(count, maxBytes);
+        } catch (std::exception& e) {
+            // reported by the next getRows that needs more rows
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("PrefetchWorker::HandleOKCallback");
+        SUBTRACT_COUNT(PREFETCH_QUE, QUE, data)
+    }
+
+    virtual void HandleErrorCallback()
+    {
+        TRACE("PrefetchWorker::HandleErrorCallback");
+        SUBTRACT_COUNT(PREFETCH_QUE, QUE, data)
+    }
+
+    NuoJsData* data;
+
+private:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    ResultSet* self;
+    std::shared_ptr<Cursor> cursor;
+    size_t count;
+    size_t maxBytes;
+};
+
+void ResultSet::startPrefetch(size_t batchSize)
+{
+    uint32_t depth = options.getPrefetchDepth();
+    if (depth == 0 || batchSize == 0 || prefetching || fetching || closed ||
+        cursor == nullptr || cursor->isExhausted()) {
+        return;
+    }
+    size_t count = batchSize * depth;
+    if (cursor->getBufferedRows() >= count) {
+        return;
+    }
+
+    prefetching = true;
+    PrefetchWorker* worker = new PrefetchWorker(this, cursor, count, options.getPrefetchMaxBytes());
+    worker->SaveToPersistent("nuodb:ResultSet", handle());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(PREFETCH_QUE, QUE, worker->data)
+}
+
 static Local<Function> dateConstructor = Local<Function>::Cast(
     Nan::Get(Nan::New<v8::Date>(0).ToLocalChecked(),
              Nan::New("constructor").ToLocalChecked()).ToLocalChecked());
 
-Local<Value> sqlToEsValue(SqlValue sqlValue)
+// ExternalAsciiString is the resource of an external string, owning the
+// buffer of a large ASCII value released from its batch.
+class ExternalAsciiString : public String::ExternalOneByteStringResource
 {
-    TRACE("ResultSet::sqlToEsValue");
-    Nan::EscapableHandleScope scope;
+public:
+    ExternalAsciiString(char* bytes, size_t length)
+        : bytes(bytes), size(length)
+    {}
+
+    ~ExternalAsciiString() override
+    {
+        free(bytes);
+    }
 
-    int sqlType = sqlValue.getSqlType();
+    const char* data() const override
+    {
+        return bytes;
+    }
+
+    size_t length() const override
+    {
+        return size;
+    }
+
+private:
+    char* bytes;
+    size_t size;
+};
+
+// newString creates the string of a cell. ASCII strings, flagged as such
+// by the decoder, are copied as one-byte strings without decoding UTF-8,
+// and large ones, which have a buffer of their own, are not copied at all.
+static inline Local<String> newString(const Cell& cell, RowBatch& batch)
+{
+    if (!(cell.flags & Cell::ASCII)) {
+        return Nan::New<String>(cell.u.s, (int)cell.length).ToLocalChecked();
+    }
+    Isolate* isolate = Isolate::GetCurrent();
+    if (cell.length >= RowBatch::EXTERNAL_STRING_BYTES) {
+        char* bytes = batch.releaseBytes(cell);
+        if (bytes == nullptr) {
+            return String::Empty(isolate);
+        }
+        // the string frees the resource once it is collected
+        return String::NewExternalOneByte(isolate, new ExternalAsciiString(bytes, cell.length)).ToLocalChecked();
+    }
+    return String::NewFromOneByte(isolate, reinterpret_cast<const uint8_t*>(cell.u.s),
+                                  NewStringType::kNormal, (int)cell.length).ToLocalChecked();
+}
+
+// sqlToEsValue creates its value in the handle scope of the caller, which
+// converts many cells in one scope rather than opening a scope per cell.
+// BIGINT values are returned as BigInt values when bigInt is set. Binary
+// values are released from the batch to become the memory of a Buffer, and
+// streamed character LOBs become Lob objects read through the cursor.
+static inline Local<Value> sqlToEsValue(const Cell& cell, RowBatch& batch, const std::shared_ptr<Cursor>& cursor,
+                                        bool bigInt)
+{
+    int sqlType = cell.sqlType;
     int esType = Type::toEsType(sqlType);
     switch (esType) {
         case ES_BOOLEAN:
-            return scope.Escape(Nan::New<Boolean>(sqlValue.getBoolean()));
+            return Nan::New<Boolean>(cell.u.b);
 
         case ES_STRING:
-            return scope.Escape(Nan::New<String>(sqlValue.getString()).ToLocalChecked());
+            return newString(cell, batch);
 
         case ES_NUMBER: {
             switch (sqlType) {
                 case NuoDB::NUOSQL_SMALLINT:
-                    return scope.Escape(Nan::New<Number>(sqlValue.getShort()));
+                    return Nan::New<Number>(cell.u.i16);
 
                 case NuoDB::NUOSQL_INTEGER:
-                    return scope.Escape(Nan::New<Number>(sqlValue.getInt()));
+                    return Nan::New<Number>(cell.u.i32);
 
                 case NuoDB::NUOSQL_DOUBLE:
-                    return scope.Escape(Nan::New<Number>(sqlValue.getDouble()));
+                    return Nan::New<Number>(cell.u.f8);
             }
-            return scope.Escape(Nan::New<Number>(sqlValue.getDouble()));
+            return Nan::New<Number>(cell.u.f8);
         }
 
         case ES_NULL:
-            return scope.Escape(Nan::Null());
+            return Nan::Null();
 
         case ES_DATE: {
+            if (cell.length == 0) {
+                // parsed natively by the decoder
+                return Nan::New<Date>(cell.u.f8).ToLocalChecked();
+            }
             switch (sqlType) {
 
                 // See: https://stackoverflow.com/questions/34158318/are-there-some-v8-functions-to-create-a-c-v8date-object-from-a-string-like
 
                 case NuoDB::NUOSQL_TIME: {
                     // Hackish, but ES doesn't actually support TIME
-                    return scope.Escape(NanDate::toDate(std::string("1970-01-01T") + sqlValue.getString()));
+                    return NanDate::toDate(std::string("1970-01-01T") + std::string(cell.u.s, cell.length));
                 }
 
                 case NuoDB::NUOSQL_DATE:
                 case NuoDB::NUOSQL_TIMESTAMP: {
-                    return scope.Escape(NanDate::toDate(sqlValue.getString()));
+                    return NanDate::toDate(std::string(cell.u.s, cell.length));
                 }
                 default: 
                     throw std::runtime_error("ES DATE type is unknown NUOSQL type");
@@ -340,52 +955,447 @@ Local<Value> sqlToEsValue(SqlValue sqlValue)
             // check for types not directly supported in the ES type system...
             switch (sqlType) {
                 case NuoDB::NUOSQL_BIGINT: {
-                    int64_t v = sqlValue.getLong();
+                    int64_t v = cell.u.i64;
+                    if (bigInt) {
+                        return BigInt::New(Isolate::GetCurrent(), v);
+                    }
                     if (MIN_SAFE_INTEGER <= v && v <= MAX_SAFE_INTEGER) {
-                        return scope.Escape(Nan::New<Number>(sqlValue.getLong()));
+                        return Nan::New<Number>(v);
                     } else {
-                        return scope.Escape(Nan::New<String>(int64ToString(v).c_str()).ToLocalChecked());
+                        return Nan::New<String>(int64ToString(v).c_str()).ToLocalChecked();
+                    }
+                }
+
+                case NuoDB::NUOSQL_BLOB: {
+                    char* bytes = batch.releaseBytes(cell);
+                    if (bytes == nullptr) {
+                        return Nan::NewBuffer(0).ToLocalChecked();
+                    }
+                    // the buffer is freed by Node when it is collected
+                    return Nan::NewBuffer(bytes, cell.length).ToLocalChecked();
+                }
+
+                case NuoDB::NUOSQL_DECIMAL: {
+                    // the unscaled value and the scale
+                    Isolate* isolate = Isolate::GetCurrent();
+                    Local<Value> pair[] = {
+                        BigInt::New(isolate, cell.u.i64),
+                        Nan::New<Number>(cell.length)
+                    };
+                    return Array::New(isolate, pair, 2);
+                }
+
+                case NuoDB::NUOSQL_CLOB: {
+                    if (cell.length == Cell::STREAMED) {
+                        return Lob::createFrom(cursor, cell.u.lob);
                     }
+                    return newString(cell, batch);
                 }
             }
         }
     }
-    TRACE("sqlToEsValue : RETURNING UNDEFINED");
-    return scope.Escape(Nan::Undefined());
+    return Nan::Undefined();
+}
+
+// CodedValues converts the cells of a batch, creating the value of each
+// dictionary coded string once and reusing it for the other cells holding
+// the same code.
+class CodedValues
+{
+public:
+    CodedValues(const std::shared_ptr<Cursor>& cursor, bool bigInt)
+        : cursor(cursor), bigInt(bigInt)
+    {}
+
+    // reset forgets the values of the previous batch, whose codes have no
+    // meaning in the next.
+    void reset(size_t width)
+    {
+        values.assign(width * RowBatch::MAX_CODES, Local<Value>());
+    }
+
+    inline Local<Value> get(const Cell& cell, size_t column, RowBatch& batch)
+    {
+        if (cell.code == 0) {
+            return sqlToEsValue(cell, batch, cursor, bigInt);
+        }
+        Local<Value>& value = values[column * RowBatch::MAX_CODES + cell.code - 1];
+        if (value.IsEmpty()) {
+            value = sqlToEsValue(cell, batch, cursor, bigInt);
+        }
+        return value;
+    }
+
+private:
+    const std::shared_ptr<Cursor>& cursor;
+    bool bigInt;
+    std::vector<Local<Value>> values;
+};
+
+// LazyColumns are the keys of lazy rows, shared by the batches of a call.
+// A duplicated column name is enumerated once, in the position of its first
+// column, with the value of its last, as in object rows.
+struct LazyColumns
+{
+    std::vector<Global<String>> keys;
+    std::vector<size_t> enumerated;
+    // the column of each name, by the hash of the name
+    std::unordered_multimap<int, size_t> index;
+
+    // find returns the column of a property, or -1 for any other property.
+    // Property names are internalized like the keys, so that a match is
+    // usually the same string.
+    int find(Local<Value> property) const
+    {
+        if (!property->IsString()) {
+            return -1;
+        }
+        Isolate* isolate = Isolate::GetCurrent();
+        Local<String> name = property.As<String>();
+        auto range = index.equal_range(name->GetIdentityHash());
+        for (auto it = range.first; it != range.second; ++it) {
+            Local<String> key = Local<String>::New(isolate, keys[it->second]);
+            if (key == name || key->StrictEquals(name)) {
+                return (int)it->second;
+            }
+        }
+        return -1;
+    }
+};
+
+// LazyBatch keeps a batch of lazy rows alive; each row refers to it from an
+// internal field, so that it is collected along with the last of its rows.
+class LazyBatch : public Nan::ObjectWrap
+{
+public:
+    LazyBatch(RowBatch batch, const std::shared_ptr<Cursor>& cursor, std::shared_ptr<LazyColumns> columns,
+              bool bigInt)
+        : batch(std::move(batch)), cursor(cursor), columns(columns), bigInt(bigInt)
+    {}
+
+    void wrap(Local<Object> object)
+    {
+        Wrap(object);
+    }
+
+    RowBatch batch;
+    std::shared_ptr<Cursor> cursor;
+    std::shared_ptr<LazyColumns> columns;
+    bool bigInt;
+};
+
+// the internal fields of a lazy row: its batch, its index in the batch, and
+// the Array of the values converted so far
+enum LazyRowField {
+    LAZY_BATCH,
+    LAZY_ROW,
+    LAZY_VALUES,
+    LAZY_FIELD_COUNT
+};
+
+static Nan::Persistent<ObjectTemplate> lazyRowTemplate;
+static Nan::Persistent<ObjectTemplate> lazyBatchTemplate;
+
+static inline LazyBatch* getLazyBatch(Local<Object> row)
+{
+    return Nan::ObjectWrap::Unwrap<LazyBatch>(row->GetInternalField(LAZY_BATCH).As<Value>().As<Object>());
+}
+
+// getLazyValues returns the converted values of a row, created on the
+// first access to any of its columns.
+static Local<Array> getLazyValues(Local<Object> row, size_t width)
+{
+    Local<Value> values = row->GetInternalField(LAZY_VALUES).As<Value>();
+    if (values->IsArray()) {
+        return values.As<Array>();
+    }
+    Local<Array> created = Nan::New<Array>((int)width);
+    row->SetInternalField(LAZY_VALUES, created);
+    return created;
+}
+
+// A column is converted the first time it is read, and the value kept, so
+// that a Buffer or Lob is only ever created once.
+static NAN_PROPERTY_GETTER(getLazyProperty)
+{
+    Local<Object> row = info.Holder();
+    LazyBatch* lazy = getLazyBatch(row);
+    int colIdx = lazy->columns->find(property);
+    if (colIdx < 0) {
+        return;
+    }
+    Local<Context> ctx = Isolate::GetCurrent()->GetCurrentContext();
+    Local<Array> values = getLazyValues(row, lazy->columns->keys.size());
+    if (values->HasOwnProperty(ctx, colIdx).FromJust()) {
+        info.GetReturnValue().Set(Nan::Get(values, colIdx).ToLocalChecked());
+        return;
+    }
+    uint32_t rowIdx = Nan::To<uint32_t>(row->GetInternalField(LAZY_ROW).As<Value>()).FromJust();
+    Local<Value> value = sqlToEsValue(lazy->batch.getRow(rowIdx)[colIdx], lazy->batch, lazy->cursor, lazy->bigInt);
+    Nan::Set(values, colIdx, value);
+    info.GetReturnValue().Set(value);
+}
+
+static NAN_PROPERTY_SETTER(setLazyProperty)
+{
+    Local<Object> row = info.Holder();
+    LazyBatch* lazy = getLazyBatch(row);
+    int colIdx = lazy->columns->find(property);
+    if (colIdx < 0) {
+        return;
+    }
+    Nan::Set(getLazyValues(row, lazy->columns->keys.size()), colIdx, value);
+    info.GetReturnValue().Set(value);
+}
+
+static NAN_PROPERTY_QUERY(queryLazyProperty)
+{
+    if (getLazyBatch(info.Holder())->columns->find(property) >= 0) {
+        info.GetReturnValue().Set(Nan::New<Integer>(PropertyAttribute::None));
+    }
 }
 
-Local<Value> ResultSet::getRowsAsJsValue()
+static NAN_PROPERTY_ENUMERATOR(enumerateLazyProperties)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    const LazyColumns& columns = *getLazyBatch(info.Holder())->columns;
+    Local<Array> names = Nan::New<Array>((int)columns.enumerated.size());
+    for (size_t index = 0; index < columns.enumerated.size(); index++) {
+        Nan::Set(names, (uint32_t)index, Local<String>::New(isolate, columns.keys[columns.enumerated[index]]));
+    }
+    info.GetReturnValue().Set(names);
+}
+
+Local<Value> ResultSet::getLazyRowsAsJsValue(RowBatches& batches)
+{
+    TRACE("ResultSet::getLazyRowsAsJsValue");
+    Nan::EscapableHandleScope scope;
+    Isolate* isolate = Isolate::GetCurrent();
+
+    if (lazyRowTemplate.IsEmpty()) {
+        Local<ObjectTemplate> rowTemplate = Nan::New<ObjectTemplate>();
+        rowTemplate->SetInternalFieldCount(LAZY_FIELD_COUNT);
+        Nan::SetNamedPropertyHandler(rowTemplate, getLazyProperty, setLazyProperty, queryLazyProperty, nullptr,
+                                     enumerateLazyProperties);
+        lazyRowTemplate.Reset(rowTemplate);
+        Local<ObjectTemplate> batchTemplate = Nan::New<ObjectTemplate>();
+        batchTemplate->SetInternalFieldCount(1);
+        lazyBatchTemplate.Reset(batchTemplate);
+    }
+
+    size_t count = 0;
+    for (const RowBatch& batch : batches) {
+        count += batch.size();
+    }
+    std::vector<Local<Value>> jsRows;
+    jsRows.reserve(count);
+    if (count > 0) {
+        const Columns& described = cursor->getColumns();
+        if (keys.size() != described.size()) {
+            createKeys(described);
+        }
+        auto columns = std::make_shared<LazyColumns>();
+        std::unordered_map<std::string, size_t> last;
+        for (size_t colIdx = 0; colIdx < described.size(); colIdx++) {
+            columns->keys.emplace_back(isolate, Local<String>::New(isolate, keys[colIdx]));
+            auto found = last.emplace(described[colIdx].name, colIdx);
+            if (found.second) {
+                columns->enumerated.push_back(colIdx);
+            } else {
+                found.first->second = colIdx;
+            }
+        }
+        for (const auto& name : last) {
+            int hash = Local<String>::New(isolate, keys[name.second])->GetIdentityHash();
+            columns->index.emplace(hash, name.second);
+        }
+
+        Local<ObjectTemplate> rowTemplate = Nan::New(lazyRowTemplate);
+        Local<ObjectTemplate> batchTemplate = Nan::New(lazyBatchTemplate);
+        for (RowBatch& batch : batches) {
+            size_t size = batch.size();
+            Local<Object> jsBatch = Nan::NewInstance(batchTemplate).ToLocalChecked();
+            LazyBatch* lazy = new LazyBatch(std::move(batch), cursor, columns, options.getBigInt());
+            lazy->wrap(jsBatch);
+            for (size_t rowIdx = 0; rowIdx < size; rowIdx++) {
+                Local<Object> jsRow = Nan::NewInstance(rowTemplate).ToLocalChecked();
+                jsRow->SetInternalField(LAZY_BATCH, jsBatch);
+                jsRow->SetInternalField(LAZY_ROW, Nan::New<Integer>((uint32_t)rowIdx));
+                jsRow->SetInternalField(LAZY_VALUES, Nan::Undefined());
+                jsRows.push_back(jsRow);
+            }
+        }
+    }
+    return scope.Escape(Array::New(isolate, jsRows.data(), jsRows.size()));
+}
+
+Local<Value> ResultSet::getRowsAsJsValue(size_t rowsToRead)
 {
     TRACE("ResultSet::getRowsAsJsValue");
     Nan::EscapableHandleScope scope;
     Isolate* isolate = Isolate::GetCurrent();
     Local<Context> ctx = isolate->GetCurrentContext();
 
-    size_t count = rows.size();
-    Local<Array> array = Nan::New<Array>(count);
-    for (size_t rowIdx = 0; rowIdx < count; rowIdx++) {
-        std::vector<SqlValue> sqlRow = rows.front();
-        rows.pop_front();
+    RowBatches batches;
+    if (cursor != nullptr) {
+        batches = cursor->take(rowsToRead);
+    }
+    if (options.getRowMode() == RowMode::ROWS_AS_LAZY_OBJECT) {
+        return scope.Escape(getLazyRowsAsJsValue(batches));
+    }
+    if (options.getRowMode() == RowMode::ROWS_AS_COLUMNS) {
+        Columns none;
+        ColumnarRows columnar(std::move(batches), cursor != nullptr ? cursor->getColumns() : none,
+                              options.getDecimalMode());
+        return scope.Escape(getColumnsAsJsValue(columnar));
+    }
+    size_t count = 0;
+    for (const RowBatch& batch : batches) {
+        count += batch.size();
+    }
+    std::vector<Local<Value>> jsRows;
+    jsRows.reserve(count);
+    std::vector<Local<Value>> jsValues;
+    CodedValues coded(cursor, options.getBigInt());
+    for (RowBatch& batch : batches) {
+        size_t width = batch.getWidth();
+        jsValues.resize(width);
+        coded.reset(width);
         if (options.getRowMode() == RowMode::ROWS_AS_OBJECT) {
-            Local<Object> jsObject = Nan::New<Object>();
-            for (size_t colIdx = 0; colIdx < sqlRow.size(); colIdx++) {
-                SqlValue sqlValue = sqlRow[colIdx];
-                Local<Value> jsKey = Nan::New<String>(sqlValue.getName()).ToLocalChecked();
-                Local<Value> jsValue = sqlToEsValue(sqlValue);
-                jsObject->Set(ctx, jsKey, jsValue).Check();
+            if (keys.size() != width) {
+                createKeys(cursor->getColumns());
+            }
+            std::vector<Local<String>> jsKeys(width);
+            for (size_t colIdx = 0; colIdx < width; colIdx++) {
+                jsKeys[colIdx] = Local<String>::New(isolate, keys[colIdx]);
+            }
+            for (size_t rowIdx = 0; rowIdx < batch.size(); rowIdx++) {
+                const Cell* sqlRow = batch.getRow(rowIdx);
+                Local<Object> jsObject = Object::New(isolate);
+                for (size_t colIdx = 0; colIdx < width; colIdx++) {
+                    jsObject->CreateDataProperty(ctx, jsKeys[colIdx], coded.get(sqlRow[colIdx], colIdx, batch)).Check();
+                }
+                jsRows.push_back(jsObject);
             }
-            array->Set(ctx, rowIdx, jsObject).Check();
         } else {
-            Local<Array> jsArray = Nan::New<Array>();
-            for (size_t colIdx = 0; colIdx < sqlRow.size(); colIdx++) {
-                SqlValue sqlValue = sqlRow[colIdx];
-                Local<Value> jsValue = sqlToEsValue(sqlValue);
-                jsArray->Set(ctx, colIdx, jsValue).Check();
+            for (size_t rowIdx = 0; rowIdx < batch.size(); rowIdx++) {
+                const Cell* sqlRow = batch.getRow(rowIdx);
+                for (size_t colIdx = 0; colIdx < width; colIdx++) {
+                    jsValues[colIdx] = coded.get(sqlRow[colIdx], colIdx, batch);
+                }
+                jsRows.push_back(Array::New(isolate, jsValues.data(), width));
             }
-            array->Set(ctx, rowIdx, jsArray).Check();
         }
     }
-    return scope.Escape(array);
+    // the batches, and their string arenas, are released here all at once
+    return scope.Escape(Array::New(isolate, jsRows.data(), jsRows.size()));
+}
+
+std::string ResultSet::getRowsAsJson(size_t count)
+{
+    TRACE("ResultSet::getRowsAsJson");
+    std::string json = "[";
+    RowBatches batches = cursor->take(count);
+    if (!batches.empty()) {
+        RowWriter writer(FILE_NDJSON, *cursor);
+        for (const RowBatch& batch : batches) {
+            for (size_t rowIdx = 0; rowIdx < batch.size(); rowIdx++) {
+                if (json.size() > 1) {
+                    json += ',';
+                }
+                writer.writeObject(batch.getRow(rowIdx), json);
+            }
+        }
+    }
+    json += ']';
+    return json;
+}
+
+// toArrayBuffer hands malloc'd memory to an ArrayBuffer, which frees it
+// when it is collected.
+static inline Local<ArrayBuffer> toArrayBuffer(char* memory, size_t length)
+{
+    return Nan::NewBuffer(memory, length).ToLocalChecked().As<Uint8Array>()->Buffer();
+}
+
+Local<Value> ResultSet::getColumnsAsJsValue(ColumnarRows& rows)
+{
+    TRACE("ResultSet::getColumnsAsJsValue");
+    Nan::EscapableHandleScope scope;
+    Isolate* isolate = Isolate::GetCurrent();
+    Local<Context> ctx = isolate->GetCurrentContext();
+
+    size_t count = rows.size();
+    size_t width = rows.getWidth();
+    if (width > 0 && keys.size() != width) {
+        createKeys(cursor->getColumns());
+    }
+    Local<Object> jsColumns = Object::New(isolate);
+    Local<Object> jsNulls = Object::New(isolate);
+    std::vector<Local<Value>> jsValues;
+    CodedValues coded(cursor, options.getBigInt());
+    for (size_t colIdx = 0; colIdx < width; colIdx++) {
+        TypedColumn& column = rows.getColumn(colIdx);
+        Local<String> key = Local<String>::New(isolate, keys[colIdx]);
+        Local<Value> jsColumn;
+        Local<Value> nulls = Nan::Null();
+        if (column.kind == TypedColumn::VALUES) {
+            jsValues.clear();
+            jsValues.reserve(count);
+            for (RowBatch& batch : rows.getBatches()) {
+                coded.reset(1);
+                for (size_t rowIdx = 0; rowIdx < batch.size(); rowIdx++) {
+                    jsValues.push_back(coded.get(batch.getRow(rowIdx)[colIdx], 0, batch));
+                }
+            }
+            jsColumn = Array::New(isolate, jsValues.data(), jsValues.size());
+        } else {
+            Local<ArrayBuffer> values = toArrayBuffer(column.values, count * column.getElementSize());
+            column.values = nullptr;
+            switch (column.kind) {
+                case TypedColumn::INT32:
+                    jsColumn = Int32Array::New(values, 0, count);
+                    break;
+                case TypedColumn::BIGINT64:
+                    jsColumn = BigInt64Array::New(values, 0, count);
+                    break;
+                default:
+                    jsColumn = Float64Array::New(values, 0, count);
+                    break;
+            }
+            if (column.nulls != nullptr) {
+                size_t length = (count + 7) / 8;
+                nulls = Uint8Array::New(toArrayBuffer(column.nulls, length), 0, length);
+                column.nulls = nullptr;
+            }
+        }
+        jsColumns->CreateDataProperty(ctx, key, jsColumn).Check();
+        jsNulls->CreateDataProperty(ctx, key, nulls).Check();
+    }
+    Local<Object> result = Object::New(isolate);
+    Nan::Set(result, Nan::New("rows").ToLocalChecked(), Nan::New<Number>((double)count));
+    Nan::Set(result, Nan::New("columns").ToLocalChecked(), jsColumns);
+    Nan::Set(result, Nan::New("nulls").ToLocalChecked(), jsNulls);
+    return scope.Escape(result);
+}
+
+NAN_METHOD(ResultSet::getRowMode)
+{
+    TRACE("ResultSet::getRowMode");
+    ResultSet* self = Nan::ObjectWrap::Unwrap<ResultSet>(info.This());
+    info.GetReturnValue().Set(Nan::New<Number>(self->options.getRowMode()));
+}
+
+void ResultSet::createKeys(const Columns& columns)
+{
+    Isolate* isolate = Isolate::GetCurrent();
+    keys.clear();
+    keys.reserve(columns.size());
+    for (const Column& column : columns) {
+        Local<String> key = String::NewFromUtf8(isolate, column.name.c_str(),
+            NewStringType::kInternalized, (int)column.name.size()).ToLocalChecked();
+        keys.emplace_back(isolate, key);
+    }
 }
 
 bool ResultSet::isStatementOpen() const
@@ -395,92 +1405,109 @@ bool ResultSet::isStatementOpen() const
 
 bool ResultSet::isResultOpen() const
 {
-    return result != nullptr;
+    return cursor != nullptr;
 }
 
-void ResultSet::doGetRows(size_t count)
+void ResultSet::doGetRows(size_t count, bool continued)
 {
     TRACE("ResultSet::doGetRows");
 
-    if (!isStatementOpen()) {
-        std::string message = ErrMsg::get(ErrMsgType::errNoStatement);
-        throw std::runtime_error(message);
+    size_t maxBytes = options.getMaxBufferedBytes();
+    if (maxBytes == 0) {
+        fetch(count, 0);
+        return;
     }
 
-    if (!isResultOpen()) {
-        result = statement->getResultSet();
+    // the fetch stops once the rows of the request would reach
+    // maxBufferedBytes; rows still missing would exceed it, and the request
+    // fails rather than silently returning fewer rows. The rows fetched so
+    // far stay buffered for smaller requests.
+    size_t used = getRequestBytes(continued);
+    if (used < maxBytes) {
+        fetch(count, maxBytes - used);
+        if (cursor->hasRows(count)) {
+            return;
+        }
+    } else if (cursor->isExhausted() && cursor->getBufferedRows() == 0) {
+        return;
     }
+    std::string message = ErrMsg::get(ErrMsgType::errMaxBufferedBytes, (unsigned long long)maxBytes);
+    throw std::runtime_error(message);
+}
 
-    if(result == nullptr){
-        // if the result set is still null at this point, there is the potential that one connection is being used for multiple queries.
-        throw std::runtime_error("Cannot access result set. Please ensure there is only one actively executing query per connection.");
+size_t ResultSet::getRequestBytes(bool continued)
+{
+    size_t taken = isResultOpen() ? cursor->getTakenBytes() : 0;
+    if (!continued) {
+        requestStart = taken;
     }
+    return taken - requestStart;
+}
 
-    bool fetchAll = count == 0;
-    NuoDB::ResultSetMetaData* metaData = result->getMetaData();
-    auto columns = metaData->getColumnCount();
-    while ((fetchAll || count > 0) && result->next()) {
-        std::vector<SqlValue> row;
-        for (auto index = 0; index < columns; index++) {
-            auto column = index + 1;
-            int sqlType = metaData->getColumnType(column);
-
-            SqlValue sqlValue;
-            sqlValue.setName(metaData->getColumnLabel(column));
-            sqlValue.setTable(metaData->getTableName(column));
-            sqlValue.setSqlType(sqlType);
-
-            switch (sqlType) {
-                case NuoDB::NUOSQL_SMALLINT:
-                    sqlValue.setShort(result->getShort(column));
-                    break;
-
-                case NuoDB::NUOSQL_INTEGER:
-                    sqlValue.setInt(result->getInt(column));
-                    break;
-
-                case NuoDB::NUOSQL_BIGINT:
-                    sqlValue.setLong(result->getLong(column));
-                    break;
+void ResultSet::fetch(size_t count, size_t maxBytes)
+{
+    if (!isStatementOpen()) {
+        std::string message = ErrMsg::get(ErrMsgType::errNoStatement);
+        throw std::runtime_error(message);
+    }
 
-                case NuoDB::NUOSQL_FLOAT: // AN ALIAS FOR DOUBLE!!!
-                case NuoDB::NUOSQL_DOUBLE:
-                    sqlValue.setDouble(result->getDouble(column));
-                    break;
+    if (!isResultOpen()) {
+        cursor = Cursor::open(statement, 0, options);
+    }
 
-                case NuoDB::NUOSQL_BOOLEAN:
-                    sqlValue.setBoolean(result->getBoolean(column));
-                    break;
+    cursor->fetch(count, maxBytes);
+}
 
-                case NuoDB::NUOSQL_DATE:
-                case NuoDB::NUOSQL_TIME:
-                case NuoDB::NUOSQL_TIMESTAMP:
-                case NuoDB::NUOSQL_CHAR:
-                case NuoDB::NUOSQL_VARCHAR:
-                case NuoDB::NUOSQL_LONGVARCHAR: {
-                    const char* s = result->getString(column);
-                    if (!result->wasNull()) {
-                        sqlValue.setString(s);
-                    }
-                    break;
+// the number of rows fetched at a time, and the size of the text written at
+// a time, by an export; the rows are taken as they are fetched, so exports
+// are not subject to maxBufferedBytes
+static const size_t EXPORT_FETCH_ROWS = 10000;
+static const size_t EXPORT_WRITE_BYTES = 1024 * 1024;
+
+// writeRows formats the rows of the cursor with the writer, fetching more
+// until it is exhausted, and hands the text to flush as it grows.
+template<typename Writer>
+static size_t writeRows(Writer& writer, Cursor& cursor, const std::function<void()>& fetch,
+                        const std::function<void(const std::string&)>& flush)
+{
+    size_t rows = 0;
+    std::string text;
+    text.reserve(EXPORT_WRITE_BYTES * 2);
+    writer.writeHeader(text);
+    for (;;) {
+        RowBatches batches = cursor.take(0);
+        for (const RowBatch& batch : batches) {
+            for (size_t rowIdx = 0; rowIdx < batch.size(); rowIdx++) {
+                writer.writeRow(batch.getRow(rowIdx), text);
+                if (text.size() >= EXPORT_WRITE_BYTES) {
+                    flush(text);
+                    text.clear();
                 }
-
-                default:
-                    const char* s = result->getString(column);
-                    if (!result->wasNull()) {
-                        sqlValue.setString(s);
-                        sqlValue.setSqlType(NuoDB::NUOSQL_VARCHAR);
-                    }
-                    break;
-            }
-            // if the last value was null, set the value to null...
-            if (result->wasNull()) {
-                sqlValue.setSqlType(NuoDB::NUOSQL_NULL);
             }
-            row.push_back(sqlValue);
+            rows += batch.size();
         }
-        count--;
-        rows.push_back(row);
+        if (cursor.isExhausted() && cursor.getBufferedRows() == 0) {
+            break;
+        }
+        fetch();
+    }
+    writer.writeTrailer(text);
+    flush(text);
+    return rows;
+}
+
+size_t ResultSet::doExportTo(FileFormat format, const std::function<void(const std::string&)>& flush)
+{
+    TRACE("ResultSet::doExportTo");
+
+    // the first fetch describes the columns
+    fetch(EXPORT_FETCH_ROWS, 0);
+    auto fetchMore = [this]() { fetch(EXPORT_FETCH_ROWS, 0); };
+    if (format == FILE_ARROW) {
+        ArrowWriter writer(*cursor);
+        return writeRows(writer, *cursor, fetchMore, flush);
     }
+    RowWriter writer(format, *cursor);
+    return writeRows(writer, *cursor, fetchMore, flush);
 }
 } // namespace NuoJs
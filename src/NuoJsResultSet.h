@@ -9,6 +9,15 @@
 #include "NuoJsAddon.h"
 #include "NuoJsOptions.h"
 #include "NuoJsValue.h"
+#include "NuoJsStatementCache.h"
+#include "NuoJsColumnar.h"
+#include "NuoJsCursor.h"
+#include "NuoJsRowWriter.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace NuoJs
 {
@@ -23,7 +32,11 @@ public:
 
     static NAN_METHOD(newInstance);
 
-    static Local<Object> createFrom(class NuoDB::Statement*, Options options);
+    static Local<Object> createFrom(class NuoDB::PreparedStatement*, Options options,
+                                    std::shared_ptr<StatementCache> statementCache, std::string sql,
+                                    std::unique_ptr<Cursor> cursor);
+    static Local<Object> createFrom(std::shared_ptr<NuoDB::PreparedStatement>, Options options,
+                                    std::unique_ptr<Cursor> cursor);
 
     static Nan::Persistent<Function> constructor;
 
@@ -32,24 +45,92 @@ private:
     // Release a database result set asynchronously.
     static NAN_METHOD(close);
     friend class ResultSetCloseWorker;
-    void doClose();
+    void doClose(std::shared_ptr<Cursor>& cursor);
 
     static NAN_METHOD(getRows);
     friend class GetRowsWorker;
-    void doGetRows(size_t);
+    void doGetRows(size_t count, bool continued);
+
+    // Opens the cursor when needed and fetches count rows, all when zero,
+    // stopping early once maxBytes are buffered when non-zero.
+    void fetch(size_t count, size_t maxBytes);
+
+    // Returns the bytes of the rows taken since the start of the current
+    // request of the application, which starts over unless continued.
+    size_t getRequestBytes(bool continued);
+    size_t requestStart = 0;
+
+    // Returns rows already fetched, without a worker, when the buffer can
+    // answer the request by itself; otherwise undefined.
+    static NAN_METHOD(getBufferedRows);
+
+    // Writes the remaining rows to a file as CSV, NDJSON or an Arrow IPC
+    // stream. The rows are fetched and formatted on a worker thread, without
+    // creating JS values.
+    static NAN_METHOD(exportTo);
+    friend class ExportWorker;
+    size_t doExportTo(FileFormat format, const std::function<void(const std::string&)>& flush);
+
+    // Returns the remaining rows as a Buffer holding an Arrow IPC stream.
+    static NAN_METHOD(getArrow);
+    friend class ArrowWorker;
+
+    // Returns the row mode of the result set, for the JS layer.
+    static NAN_METHOD(getRowMode);
 
-    // Internal method to convert row buffers to a Napi::Array.
-    Local<Value> getRowsAsJsValue();
+    // Internal method to convert up to count buffered rows to a Napi::Array.
+    Local<Value> getRowsAsJsValue(size_t count);
 
-    class NuoDB::Statement* statement = nullptr;
+    // Converts rows transposed into columns to an Object of columns, the
+    // numeric ones typed arrays over the memory filled natively.
+    Local<Value> getColumnsAsJsValue(ColumnarRows& rows);
+
+    // Converts rows to lazy row objects, whose columns are converted on
+    // first access.
+    Local<Value> getLazyRowsAsJsValue(RowBatches& batches);
+
+    // Writes up to count buffered rows as the JSON text of an Array of
+    // Objects, without V8.
+    std::string getRowsAsJson(size_t count);
+
+    // Column names as internalized strings, created once per result set;
+    // rows built with the same keys in the same order share a hidden class.
+    std::vector<Global<String>> keys;
+    void createKeys(const Columns& columns);
+
+    class NuoDB::PreparedStatement* statement = nullptr;
     bool isStatementOpen() const;
 
-    class NuoDB::ResultSet* result = nullptr;
+    // The statement is handed back to the connection statement cache it was
+    // borrowed from once the result set is closed. Statements explicitly
+    // prepared by the application are instead shared with the Statement
+    // object, and are only closed once neither needs them any more.
+    std::shared_ptr<StatementCache> statementCache;
+    std::string sql;
+    std::shared_ptr<NuoDB::PreparedStatement> sharedStatement;
+    void releaseStatement();
+
+    // rows are buffered by the cursor, which may already hold the first
+    // batch fetched along with the execution
+    std::shared_ptr<Cursor> cursor;
     bool isResultOpen() const;
 
+    // set while a worker is fetching into the cursor
+    bool fetching = false;
+
+    // Read-ahead: once a batch of rows is handed to JS, up to prefetchDepth
+    // more batches of the same size are fetched in the background.
+    friend class PrefetchWorker;
+    void startPrefetch(size_t batchSize);
+    bool prefetching = false;
+
     Options options;
-    std::deque<std::vector<SqlValue> > rows;
 
+    // set on the main thread by the first close, which takes the cursor
+    bool closed = false;
+
+    // set by the worker closing the cursor; the statement is released on
+    // the same worker
     bool hasBeenClosed = false;
 };
 } // namespace NuoJs
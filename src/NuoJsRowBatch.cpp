@@ -0,0 +1,194 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsRowBatch.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace NuoJs
+{
+char* Arena::allocate(size_t size)
+{
+    if (size > available) {
+        // large strings get a chunk of their own, leaving the current
+        // chunk in use for the strings that follow
+        if (size > CHUNK_SIZE / 4) {
+            chunks.emplace_back(new char[size]);
+            bytes += size;
+            return chunks.back().get();
+        }
+        chunks.emplace_back(new char[CHUNK_SIZE]);
+        next = chunks.back().get();
+        available = CHUNK_SIZE;
+        bytes += CHUNK_SIZE;
+    }
+    char* allocated = next;
+    next += size;
+    available -= size;
+    return allocated;
+}
+
+Arena::~Arena()
+{
+    for (char* buffer : buffers) {
+        free(buffer);
+    }
+}
+
+char* Arena::allocateBuffer(size_t size)
+{
+    // never zero, so that an empty value still has a unique buffer
+    char* buffer = static_cast<char*>(malloc(size > 0 ? size : 1));
+    if (buffer == nullptr) {
+        throw std::bad_alloc();
+    }
+    buffers.insert(buffer);
+    bytes += size;
+    return buffer;
+}
+
+char* Arena::releaseBuffer(const char* buffer)
+{
+    auto it = buffers.find(const_cast<char*>(buffer));
+    if (it == buffers.end()) {
+        return nullptr;
+    }
+    char* released = *it;
+    buffers.erase(it);
+    return released;
+}
+
+size_t Arena::getBytes() const
+{
+    return bytes;
+}
+
+RowBatch::RowBatch(size_t width)
+    : width(width), arena(std::make_shared<Arena>())
+{}
+
+RowBatch::RowBatch(size_t width, std::shared_ptr<Arena> arena)
+    : width(width), arena(arena)
+{}
+
+Cell* RowBatch::addRow()
+{
+    size_t offset = cells.size();
+    cells.resize(offset + width);
+    return cells.data() + offset;
+}
+
+// isAscii looks for a byte with its high bit set eight bytes at a time; the
+// loop has no branch on the data, so that the compiler can vectorize it.
+static inline bool isAscii(const char* s, size_t length)
+{
+    uint64_t bits = 0;
+    size_t index = 0;
+    for (; index + sizeof(uint64_t) <= length; index += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, s + index, sizeof(uint64_t));
+        bits |= word;
+    }
+    for (; index < length; index++) {
+        bits |= (unsigned char)s[index];
+    }
+    return (bits & 0x8080808080808080ULL) == 0;
+}
+
+void RowBatch::setString(Cell& cell, const char* s, size_t length)
+{
+    bool ascii = isAscii(s, length);
+    char* bytes = ascii && length >= EXTERNAL_STRING_BYTES ? arena->allocateBuffer(length) : arena->allocate(length);
+    memcpy(bytes, s, length);
+    cell.u.s = bytes;
+    cell.length = (uint32_t)length;
+    cell.flags = ascii ? Cell::ASCII : 0;
+    cell.code = 0;
+    stringBytes += length;
+}
+
+void RowBatch::setCodedString(Cell& cell, size_t column, const char* s, size_t length)
+{
+    if (dictionaries.empty()) {
+        dictionaries.resize(width);
+    }
+    Dictionary& dictionary = dictionaries[column];
+    if (dictionary.full || length > MAX_CODED_BYTES) {
+        setString(cell, s, length);
+        return;
+    }
+    auto it = dictionary.cells.find(std::string_view(s, length));
+    if (it != dictionary.cells.end()) {
+        // the bytes are shared, and only counted once
+        cell.u.s = it->second.u.s;
+        cell.length = it->second.length;
+        cell.flags = it->second.flags;
+        cell.code = it->second.code;
+        return;
+    }
+    setString(cell, s, length);
+    if (dictionary.cells.size() == MAX_CODES) {
+        // too many distinct values for a dictionary to pay off
+        dictionary.full = true;
+        dictionary.cells.clear();
+        return;
+    }
+    cell.code = (uint8_t)(dictionary.cells.size() + 1);
+    dictionary.cells.emplace(std::string_view(cell.u.s, length), cell);
+}
+
+void RowBatch::releaseDictionaries()
+{
+    std::vector<Dictionary>().swap(dictionaries);
+}
+
+char* RowBatch::allocateBytes(Cell& cell, size_t length)
+{
+    char* bytes = arena->allocateBuffer(length);
+    cell.u.s = bytes;
+    cell.length = (uint32_t)length;
+    stringBytes += length;
+    return bytes;
+}
+
+char* RowBatch::releaseBytes(const Cell& cell)
+{
+    return arena->releaseBuffer(cell.u.s);
+}
+
+size_t RowBatch::getWidth() const
+{
+    return width;
+}
+
+size_t RowBatch::size() const
+{
+    return width == 0 ? 0 : cells.size() / width - first;
+}
+
+const Cell* RowBatch::getRow(size_t row) const
+{
+    return cells.data() + (first + row) * width;
+}
+
+size_t RowBatch::getBytes() const
+{
+    return size() * width * sizeof(Cell) + stringBytes;
+}
+
+RowBatch RowBatch::split(size_t count)
+{
+    RowBatch head(width, arena);
+    const Cell* begin = getRow(0);
+    head.cells.assign(begin, begin + count * width);
+    // string bytes are attributed in proportion to the rows
+    head.stringBytes = stringBytes * count / size();
+    stringBytes -= head.stringBytes;
+    first += count;
+    return head;
+}
+} // namespace NuoJs
@@ -0,0 +1,158 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_ROWBATCH_H
+#define NUOJS_ROWBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace NuoDB
+{
+class Clob;
+}
+
+namespace NuoJs
+{
+// Cell is the compact value of one column of a fetched row. Strings point
+// into the arena of the batch holding the row and are not terminated. A
+// character LOB left to be streamed has the length STREAMED. Strings found
+// to be pure ASCII when they were stored are flagged ASCII, so that they can
+// become one-byte strings without being decoded as UTF-8. A string coded
+// by the dictionary of its column has a code from 1 to RowBatch::MAX_CODES,
+// shared by the cells of the batch holding the same string, and 0 otherwise.
+struct Cell
+{
+    static const uint32_t STREAMED = UINT32_MAX;
+    static const uint8_t ASCII = 1;
+
+    union
+    {
+        bool b;
+        int16_t i16;
+        int32_t i32;
+        int64_t i64;
+        double f8;
+        const char* s;
+        NuoDB::Clob* lob;
+    } u;
+    uint32_t length;
+    int16_t sqlType;
+    uint8_t flags;
+    uint8_t code;
+};
+static_assert(sizeof(Cell) == 16, "a cell is expected to be 16 bytes");
+
+// Arena is a bump allocator for the string bytes of a batch of rows. Its
+// memory is only released, all at once, when the arena is destroyed.
+// Binary values are instead given buffers of their own, which can be
+// released from the arena and handed to ES without copying.
+class Arena
+{
+public:
+    Arena() = default;
+    ~Arena();
+
+    char* allocate(size_t size);
+
+    // allocateBuffer mallocs a buffer, freed with the arena unless released.
+    char* allocateBuffer(size_t size);
+
+    // releaseBuffer passes ownership of a buffer to the caller, who must
+    // free it. It returns null if the buffer was already released.
+    char* releaseBuffer(const char* buffer);
+
+    size_t getBytes() const;
+
+private:
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* next = nullptr;
+    size_t available = 0;
+    size_t bytes = 0;
+    std::unordered_set<char*> buffers;
+};
+
+// RowBatch holds rows of cells, stored contiguously row after row, and the
+// arena their strings are allocated in. Batches are moved, never copied;
+// splitting a batch copies only cells, the arena is shared.
+class RowBatch
+{
+public:
+    explicit RowBatch(size_t width);
+    RowBatch(RowBatch&&) = default;
+    RowBatch& operator=(RowBatch&&) = default;
+
+    // addRow appends a row and returns its cells to be filled in.
+    Cell* addRow();
+
+    // ASCII strings of at least this size are given buffers of their own,
+    // like binary values, to be handed to ES as external strings.
+    static const size_t EXTERNAL_STRING_BYTES = 64 * 1024;
+
+    // setString copies a string into the arena and points the cell at it,
+    // flagging the cell when the string is pure ASCII.
+    void setString(Cell& cell, const char* s, size_t length);
+
+    // Strings of a column are dictionary encoded while the column has at
+    // most MAX_CODES distinct short values in the batch; past that, the
+    // column is left uncoded for the rest of the batch.
+    static const size_t MAX_CODES = 255;
+    static const size_t MAX_CODED_BYTES = 64;
+
+    // setCodedString is setString for a value of the given column, sharing
+    // the bytes and the code of an equal string already in the batch.
+    void setCodedString(Cell& cell, size_t column, const char* s, size_t length);
+
+    // releaseDictionaries frees the dictionaries once no more rows are to
+    // be added; the codes stay in the cells.
+    void releaseDictionaries();
+
+    // allocateBytes points the cell at a buffer of its own, to be filled
+    // in, for a binary value.
+    char* allocateBytes(Cell& cell, size_t length);
+
+    // releaseBytes passes ownership of the buffer of a binary value, or of a
+    // large ASCII string, to the caller, who must free it.
+    char* releaseBytes(const Cell& cell);
+
+    size_t getWidth() const;
+    size_t size() const;
+    const Cell* getRow(size_t row) const;
+
+    // an estimate of the memory held by the rows of the batch
+    size_t getBytes() const;
+
+    // split removes the first count rows into a new batch.
+    RowBatch split(size_t count);
+
+private:
+    RowBatch(size_t width, std::shared_ptr<Arena> arena);
+
+    size_t width;
+    size_t first = 0;
+    std::vector<Cell> cells;
+    std::shared_ptr<Arena> arena;
+    size_t stringBytes = 0;
+
+    // the first cell of each coded string, by value, for each column
+    struct Dictionary
+    {
+        std::unordered_map<std::string_view, Cell> cells;
+        bool full = false;
+    };
+    std::vector<Dictionary> dictionaries;
+};
+typedef std::deque<RowBatch> RowBatches;
+} // namespace NuoJs
+
+#endif
@@ -9,11 +9,16 @@
 namespace NuoJs
 {
 // RowMode controls how results are returned; results may be returned as an
-// Array of Value objects, or as an Object with the keys matching the column
-// names.
+// Array of Value objects, as an Object with the keys matching the column
+// names, transposed into columns, with numeric columns as typed arrays, as
+// the JSON text of an Array of such Objects, or as Objects that convert
+// each column only when it is first read.
 enum RowMode {
     ROWS_AS_ARRAY, // default
-    ROWS_AS_OBJECT
+    ROWS_AS_OBJECT,
+    ROWS_AS_COLUMNS,
+    ROWS_AS_JSON,
+    ROWS_AS_LAZY_OBJECT
 };
 }
 
@@ -0,0 +1,506 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsRowReader.h"
+#include "NuoJsErrMsg.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace NuoJs
+{
+// the size of the reads of the file
+static const size_t READ_SIZE = 1024 * 1024;
+
+RowReader::RowReader(FileFormat format, int fd)
+    : format(format), fd(fd)
+{}
+
+const std::vector<std::string>& RowReader::getNames() const
+{
+    return names;
+}
+
+bool RowReader::readRow(Binds& row)
+{
+    return format == FILE_CSV ? readCsvRow(row) : readJsonRow(row);
+}
+
+void RowReader::malformed() const
+{
+    std::string message = ErrMsg::get(ErrMsgType::errLoadRecord, (int)line);
+    throw std::runtime_error(message);
+}
+
+// fill reads the next block of the file, first dropping the text already
+// parsed. It returns false at the end of the file.
+bool RowReader::fill()
+{
+    if (eof) {
+        return false;
+    }
+    if (position > 0) {
+        buffer.erase(0, position);
+        scanned -= position;
+        position = 0;
+    }
+    size_t size = buffer.size();
+    buffer.resize(size + READ_SIZE);
+    ssize_t count;
+    do {
+        count = ::read(fd, &buffer[size], READ_SIZE);
+    } while (count < 0 && errno == EINTR);
+    if (count < 0) {
+        buffer.resize(size);
+        std::string message = ErrMsg::get(ErrMsgType::errLoadFile, strerror(errno));
+        throw std::runtime_error(message);
+    }
+    buffer.resize(size + (size_t)count);
+    if (count == 0) {
+        eof = true;
+        return false;
+    }
+    return true;
+}
+
+// nextRecord finds the end of the record at position: the next line break
+// outside of a quoted CSV field, or the end of the file. It returns false
+// when no text is left.
+bool RowReader::nextRecord(size_t& end)
+{
+    bool csv = format == FILE_CSV;
+    do {
+        for (; scanned < buffer.size(); scanned++) {
+            char c = buffer[scanned];
+            if (csv && c == '"') {
+                quoted = !quoted;
+            } else if (c == '\n' && !quoted) {
+                end = scanned++;
+                return true;
+            }
+        }
+    } while (fill());
+    if (position == buffer.size()) {
+        return false;
+    }
+    // the last record has no line break
+    end = buffer.size();
+    quoted = false;
+    return true;
+}
+
+bool RowReader::readCsvRow(Binds& row)
+{
+    for (;;) {
+        size_t end;
+        if (!nextRecord(end)) {
+            return false;
+        }
+        const char* s = buffer.data() + position;
+        const char* e = buffer.data() + end;
+        size_t breaks = std::count(s, e, '\n');
+        if (e > s && e[-1] == '\r') {
+            e--;
+        }
+        Binds fields;
+        if (s < e) {
+            parseCsvRecord(s, e, fields);
+        }
+        position = std::min(end + 1, buffer.size());
+        size_t first = line;
+        line += breaks + 1;
+        if (fields.empty()) {
+            // a blank line
+            continue;
+        }
+
+        if (names.empty()) {
+            for (const SqlValue& field : fields) {
+                if (field.getSqlType() == NuoDB::NUOSQL_NULL) {
+                    line = first;
+                    malformed();
+                }
+                names.push_back(field.getString());
+            }
+            continue;
+        }
+        if (fields.size() != names.size()) {
+            line = first;
+            malformed();
+        }
+        row = std::move(fields);
+        return true;
+    }
+}
+
+void RowReader::parseCsvRecord(const char* s, const char* end, Binds& fields)
+{
+    const char* p = s;
+    for (;;) {
+        SqlValue value;
+        if (p < end && *p == '"') {
+            // a quote within a quoted field is doubled
+            std::string text;
+            p++;
+            for (;;) {
+                const char* q = static_cast<const char*>(memchr(p, '"', end - p));
+                if (q == nullptr) {
+                    malformed();
+                }
+                text.append(p, q - p);
+                p = q + 1;
+                if (p < end && *p == '"') {
+                    text += '"';
+                    p++;
+                } else {
+                    break;
+                }
+            }
+            if (p < end && *p != ',') {
+                malformed();
+            }
+            value.setSqlType(NuoDB::NUOSQL_VARCHAR);
+            value.setString(std::move(text));
+        } else {
+            const char* q = static_cast<const char*>(memchr(p, ',', end - p));
+            if (q == nullptr) {
+                q = end;
+            }
+            if (memchr(p, '"', q - p) != nullptr) {
+                malformed();
+            }
+            if (q > p) {
+                value.setSqlType(NuoDB::NUOSQL_VARCHAR);
+                value.setString(std::string(p, q - p));
+            }
+            p = q;
+        }
+        fields.push_back(std::move(value));
+        if (p == end) {
+            break;
+        }
+        // the comma
+        p++;
+    }
+}
+
+static inline void skipSpace(const char*& p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+        p++;
+    }
+}
+
+static bool parseHex(const char* p, const char* end, uint32_t& code)
+{
+    if (end - p < 4) {
+        return false;
+    }
+    code = 0;
+    for (int index = 0; index < 4; index++) {
+        char c = p[index];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        code = code * 16 + digit;
+    }
+    return true;
+}
+
+static void appendUtf8(uint32_t code, std::string& out)
+{
+    if (code < 0x80) {
+        out += (char)code;
+    } else if (code < 0x800) {
+        out += (char)(0xC0 | (code >> 6));
+        out += (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += (char)(0xE0 | (code >> 12));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    } else {
+        out += (char)(0xF0 | (code >> 18));
+        out += (char)(0x80 | ((code >> 12) & 0x3F));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+// parseString parses a JSON string, p being at its opening quote.
+static bool parseString(const char*& p, const char* end, std::string& out)
+{
+    p++;
+    const char* run = p;
+    while (p < end) {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"') {
+            out.append(run, p - run);
+            p++;
+            return true;
+        }
+        if (c < 0x20) {
+            return false;
+        }
+        if (c != '\\') {
+            p++;
+            continue;
+        }
+        out.append(run, p - run);
+        if (++p == end) {
+            return false;
+        }
+        switch (*p++) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t code;
+                if (!parseHex(p, end, code)) {
+                    return false;
+                }
+                p += 4;
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    // a surrogate pair, else a lone surrogate
+                    uint32_t low;
+                    if (end - p >= 6 && p[0] == '\\' && p[1] == 'u' && parseHex(p + 2, end, low) &&
+                        low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        p += 6;
+                    } else {
+                        code = 0xFFFD;
+                    }
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    code = 0xFFFD;
+                }
+                appendUtf8(code, out);
+                break;
+            }
+            default:
+                return false;
+        }
+        run = p;
+    }
+    return false;
+}
+
+// skipNested skips a JSON object or array, p being at its opening bracket.
+static bool skipNested(const char*& p, const char* end)
+{
+    int depth = 0;
+    while (p < end) {
+        char c = *p;
+        if (c == '"') {
+            std::string ignored;
+            if (!parseString(p, end, ignored)) {
+                return false;
+            }
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0) {
+                p++;
+                return true;
+            }
+        }
+        p++;
+    }
+    return false;
+}
+
+static inline bool isDigit(const char* p, const char* end)
+{
+    return p < end && *p >= '0' && *p <= '9';
+}
+
+static bool parseValue(const char*& p, const char* end, SqlValue& value)
+{
+    if (p == end) {
+        return false;
+    }
+    const char* start = p;
+    char c = *p;
+    if (c == '"') {
+        std::string text;
+        if (!parseString(p, end, text)) {
+            return false;
+        }
+        value.setSqlType(NuoDB::NUOSQL_VARCHAR);
+        value.setString(std::move(text));
+    } else if (c == '{' || c == '[') {
+        if (!skipNested(p, end)) {
+            return false;
+        }
+        value.setSqlType(NuoDB::NUOSQL_VARCHAR);
+        value.setString(std::string(start, p - start));
+    } else if (end - p >= 4 && strncmp(p, "true", 4) == 0) {
+        p += 4;
+        value.setSqlType(NuoDB::NUOSQL_BOOLEAN);
+        value.setBoolean(true);
+    } else if (end - p >= 5 && strncmp(p, "false", 5) == 0) {
+        p += 5;
+        value.setSqlType(NuoDB::NUOSQL_BOOLEAN);
+        value.setBoolean(false);
+    } else if (end - p >= 4 && strncmp(p, "null", 4) == 0) {
+        p += 4;
+        value.setSqlType(NuoDB::NUOSQL_NULL);
+    } else {
+        // a number; integers that fit are bound as such, any other number
+        // as its text so that decimals keep every digit
+        bool integral = true;
+        if (*p == '-') {
+            p++;
+        }
+        if (!isDigit(p, end)) {
+            return false;
+        }
+        while (isDigit(p, end)) {
+            p++;
+        }
+        if (p < end && *p == '.') {
+            integral = false;
+            p++;
+            if (!isDigit(p, end)) {
+                return false;
+            }
+            while (isDigit(p, end)) {
+                p++;
+            }
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            integral = false;
+            p++;
+            if (p < end && (*p == '+' || *p == '-')) {
+                p++;
+            }
+            if (!isDigit(p, end)) {
+                return false;
+            }
+            while (isDigit(p, end)) {
+                p++;
+            }
+        }
+        int64_t v;
+        if (integral && std::from_chars(start, p, v).ec == std::errc()) {
+            value.setSqlType(NuoDB::NUOSQL_BIGINT);
+            value.setLong(v);
+        } else {
+            value.setSqlType(NuoDB::NUOSQL_VARCHAR);
+            value.setString(std::string(start, p - start));
+        }
+    }
+    return true;
+}
+
+void RowReader::parseJsonObject(const char* s, const char* end, std::vector<std::string>& keys, Binds& values)
+{
+    const char* p = s;
+    skipSpace(p, end);
+    if (p == end || *p++ != '{') {
+        malformed();
+    }
+    skipSpace(p, end);
+    if (p < end && *p == '}') {
+        p++;
+    } else {
+        for (;;) {
+            std::string key;
+            SqlValue value;
+            if (p == end || *p != '"' || !parseString(p, end, key)) {
+                malformed();
+            }
+            skipSpace(p, end);
+            if (p == end || *p++ != ':') {
+                malformed();
+            }
+            skipSpace(p, end);
+            if (!parseValue(p, end, value)) {
+                malformed();
+            }
+            keys.push_back(std::move(key));
+            values.push_back(std::move(value));
+            skipSpace(p, end);
+            if (p == end) {
+                malformed();
+            }
+            char c = *p++;
+            if (c == '}') {
+                break;
+            }
+            if (c != ',') {
+                malformed();
+            }
+            skipSpace(p, end);
+        }
+    }
+    skipSpace(p, end);
+    if (p != end) {
+        malformed();
+    }
+}
+
+bool RowReader::readJsonRow(Binds& row)
+{
+    for (;;) {
+        size_t end;
+        if (!nextRecord(end)) {
+            return false;
+        }
+        const char* s = buffer.data() + position;
+        const char* e = buffer.data() + end;
+        skipSpace(s, e);
+        if (s == e) {
+            // a blank line
+            position = std::min(end + 1, buffer.size());
+            line++;
+            continue;
+        }
+
+        std::vector<std::string> keys;
+        Binds values;
+        parseJsonObject(s, e, keys, values);
+        if (names.empty()) {
+            for (const std::string& key : keys) {
+                if (columns.emplace(key, names.size()).second) {
+                    names.push_back(key);
+                }
+            }
+            if (names.empty()) {
+                malformed();
+            }
+        }
+
+        // values bind by key; a repeated key keeps its last value
+        row.assign(names.size(), SqlValue());
+        for (size_t index = 0; index < keys.size(); index++) {
+            auto it = columns.find(keys[index]);
+            if (it == columns.end()) {
+                malformed();
+            }
+            row[it->second] = std::move(values[index]);
+        }
+        position = std::min(end + 1, buffer.size());
+        line++;
+        return true;
+    }
+}
+} // namespace NuoJs
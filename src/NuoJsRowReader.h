@@ -0,0 +1,69 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_ROWREADER_H
+#define NUOJS_ROWREADER_H
+
+#include "NuoJsBinds.h"
+#include "NuoJsFileFormat.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NuoJs
+{
+// RowReader parses the rows of a CSV or NDJSON file into bind values,
+// natively and without V8, so that a load runs entirely on a worker thread.
+// The file is read in large blocks.
+//
+// A CSV file starts with a header row of column names. Fields are bound as
+// strings, for the database to convert, and an empty unquoted field is NULL.
+// An NDJSON file holds one object per line; the keys of the first object
+// name the columns, and later objects bind their values by key, with any
+// missing key NULL. Strings, booleans and null are bound as such, integers
+// as BIGINT, other numbers as their text, and nested objects and arrays as
+// their JSON text.
+class RowReader
+{
+public:
+    RowReader(FileFormat format, int fd);
+
+    // readRow parses the next row, returning false at the end of the file.
+    bool readRow(Binds& row);
+
+    // getNames returns the column names, known once a row has been read.
+    const std::vector<std::string>& getNames() const;
+
+private:
+    FileFormat format;
+    int fd;
+
+    // the unparsed text, from position, and how far a record end has been
+    // looked for
+    std::string buffer;
+    size_t position = 0;
+    size_t scanned = 0;
+    bool quoted = false;
+    bool eof = false;
+    bool fill();
+    bool nextRecord(size_t& end);
+
+    // the line the next record starts on, for errors
+    size_t line = 1;
+    void malformed() const;
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, size_t> columns;
+
+    bool readCsvRow(Binds& row);
+    void parseCsvRecord(const char* s, const char* end, Binds& fields);
+
+    bool readJsonRow(Binds& row);
+    void parseJsonObject(const char* s, const char* end, std::vector<std::string>& keys, Binds& values);
+};
+} // namespace NuoJs
+
+#endif
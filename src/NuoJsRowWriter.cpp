@@ -0,0 +1,284 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsRowWriter.h"
+#include "NuoJsTypes.h"
+#include "NuoJsDateCodec.h"
+#include "NuoJsDecimal.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace NuoJs
+{
+// the size of the reads of a streamed character LOB
+static const size_t LOB_CHUNK_SIZE = 64 * 1024;
+
+static const char BASE64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static void writeBase64(const unsigned char* bytes, size_t length, std::string& out)
+{
+    size_t index = 0;
+    for (; index + 3 <= length; index += 3) {
+        uint32_t v = (bytes[index] << 16) | (bytes[index + 1] << 8) | bytes[index + 2];
+        out += BASE64[(v >> 18) & 63];
+        out += BASE64[(v >> 12) & 63];
+        out += BASE64[(v >> 6) & 63];
+        out += BASE64[v & 63];
+    }
+    if (index < length) {
+        uint32_t v = bytes[index] << 16;
+        if (index + 1 < length) {
+            v |= bytes[index + 1] << 8;
+        }
+        out += BASE64[(v >> 18) & 63];
+        out += BASE64[(v >> 12) & 63];
+        out += index + 1 < length ? BASE64[(v >> 6) & 63] : '=';
+        out += '=';
+    }
+}
+
+template<typename T>
+static void writeNumber(T value, std::string& out)
+{
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr - buffer);
+}
+
+RowWriter::RowWriter(FileFormat format, Cursor& cursor)
+    : format(format), cursor(cursor)
+{
+    for (const Column& column : cursor.getColumns()) {
+        std::string name;
+        writeText(column.name.c_str(), column.name.size(), name);
+        if (format == FILE_NDJSON) {
+            name += ':';
+        }
+        names.push_back(name);
+    }
+}
+
+void RowWriter::writeHeader(std::string& out)
+{
+    if (format != FILE_CSV || names.empty()) {
+        return;
+    }
+    for (size_t index = 0; index < names.size(); index++) {
+        if (index > 0) {
+            out += ',';
+        }
+        out += names[index];
+    }
+    out += "\r\n";
+}
+
+void RowWriter::writeRow(const Cell* row, std::string& out)
+{
+    size_t width = names.size();
+    if (format == FILE_CSV) {
+        for (size_t index = 0; index < width; index++) {
+            if (index > 0) {
+                out += ',';
+            }
+            writeCell(row[index], out);
+        }
+        out += "\r\n";
+    } else {
+        writeObject(row, out);
+        out += '\n';
+    }
+}
+
+void RowWriter::writeObject(const Cell* row, std::string& out)
+{
+    out += '{';
+    for (size_t index = 0; index < names.size(); index++) {
+        if (index > 0) {
+            out += ',';
+        }
+        out += names[index];
+        writeCell(row[index], out);
+    }
+    out += '}';
+}
+
+void RowWriter::writeCell(const Cell& cell, std::string& out)
+{
+    bool json = format == FILE_NDJSON;
+    switch (cell.sqlType) {
+        case NuoDB::NUOSQL_NULL:
+            if (json) {
+                out += "null";
+            }
+            break;
+
+        case NuoDB::NUOSQL_BOOLEAN:
+            out += cell.u.b ? "true" : "false";
+            break;
+
+        case NuoDB::NUOSQL_SMALLINT:
+            writeNumber(cell.u.i16, out);
+            break;
+
+        case NuoDB::NUOSQL_INTEGER:
+            writeNumber(cell.u.i32, out);
+            break;
+
+        case NuoDB::NUOSQL_BIGINT: {
+            // as getRows, integers beyond the safe range are strings in JSON
+            int64_t v = cell.u.i64;
+            bool quote = json && (v < MIN_SAFE_INTEGER || v > MAX_SAFE_INTEGER);
+            if (quote) {
+                out += '"';
+            }
+            writeNumber(v, out);
+            if (quote) {
+                out += '"';
+            }
+            break;
+        }
+
+        case NuoDB::NUOSQL_FLOAT:
+        case NuoDB::NUOSQL_DOUBLE: {
+            double v = cell.u.f8;
+            if (std::isfinite(v)) {
+                appendNumber(v, out);
+            } else if (json) {
+                out += "null";
+            } else {
+                out += std::isnan(v) ? "NaN" : v > 0 ? "Infinity" : "-Infinity";
+            }
+            break;
+        }
+
+        case NuoDB::NUOSQL_DECIMAL: {
+            // decimals are strings in JSON, as they are by default in rows
+            if (json) {
+                out += '"';
+            }
+            appendDecimal(cell.u.i64, cell.length, out);
+            if (json) {
+                out += '"';
+            }
+            break;
+        }
+
+        case NuoDB::NUOSQL_DATE:
+        case NuoDB::NUOSQL_TIME:
+        case NuoDB::NUOSQL_TIMESTAMP: {
+            if (cell.length != 0) {
+                // not parsed by the decoder, written as read
+                writeText(cell.u.s, cell.length, out);
+            } else if (std::isnan(cell.u.f8)) {
+                if (json) {
+                    out += "null";
+                }
+            } else {
+                char buffer[32];
+                formatIsoString((int64_t)cell.u.f8, buffer, sizeof(buffer));
+                writeText(buffer, strlen(buffer), out);
+            }
+            break;
+        }
+
+        case NuoDB::NUOSQL_BLOB:
+            if (json) {
+                out += '"';
+            }
+            writeBase64(reinterpret_cast<const unsigned char*>(cell.u.s), cell.length, out);
+            if (json) {
+                out += '"';
+            }
+            break;
+
+        case NuoDB::NUOSQL_CLOB:
+            if (cell.length == Cell::STREAMED) {
+                writeLob(cell.u.lob, out);
+            } else {
+                writeText(cell.u.s, cell.length, out);
+            }
+            break;
+
+        default:
+            writeText(cell.u.s, cell.length, out);
+            break;
+    }
+}
+
+void RowWriter::writeText(const char* s, size_t length, std::string& out)
+{
+    if (format == FILE_CSV) {
+        // an empty string is quoted to tell it apart from NULL
+        bool quote = length == 0;
+        for (size_t index = 0; index < length && !quote; index++) {
+            char c = s[index];
+            quote = c == ',' || c == '"' || c == '\r' || c == '\n';
+        }
+        if (!quote) {
+            out.append(s, length);
+            return;
+        }
+    }
+    out += '"';
+    writeEscaped(s, length, out);
+    out += '"';
+}
+
+void RowWriter::writeLob(NuoDB::Clob* lob, std::string& out)
+{
+    // the length is unknown until read, so the field is always quoted
+    std::vector<char> buffer(LOB_CHUNK_SIZE);
+    size_t offset = 0;
+    bool end = false;
+    out += '"';
+    while (!end) {
+        size_t read = cursor.readLob(lob, offset, buffer.size(), buffer.data(), end);
+        writeEscaped(buffer.data(), read, out);
+        offset += read;
+    }
+    out += '"';
+}
+
+void RowWriter::writeEscaped(const char* s, size_t length, std::string& out)
+{
+    static const char HEX[] = "0123456789abcdef";
+    size_t start = 0;
+    for (size_t index = 0; index < length; index++) {
+        unsigned char c = (unsigned char)s[index];
+        if (format == FILE_CSV) {
+            if (c == '"') {
+                // doubled, the first copy written with the run before it
+                out.append(s + start, index + 1 - start);
+                start = index;
+            }
+            continue;
+        }
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(s + start, index - start);
+        start = index + 1;
+        out += '\\';
+        switch (c) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '\b': out += 'b'; break;
+            case '\f': out += 'f'; break;
+            case '\n': out += 'n'; break;
+            case '\r': out += 'r'; break;
+            case '\t': out += 't'; break;
+            default:
+                out += "u00";
+                out += HEX[c >> 4];
+                out += HEX[c & 15];
+                break;
+        }
+    }
+    out.append(s + start, length - start);
+}
+} // namespace NuoJs
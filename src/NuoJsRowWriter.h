@@ -0,0 +1,62 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_ROWWRITER_H
+#define NUOJS_ROWWRITER_H
+
+#include "NuoJsCursor.h"
+#include "NuoJsFileFormat.h"
+#include "NuoJsRowBatch.h"
+
+#include <string>
+#include <vector>
+
+namespace NuoJs
+{
+// RowWriter formats fetched rows as text, natively and without V8, so that
+// an export, or rows returned as JSON, are written entirely on a worker
+// thread.
+//
+// CSV follows RFC 4180: a header row of column names, fields quoted only
+// when they hold a comma, a quote or a line break or are empty strings, and
+// NULL as an empty field. NDJSON writes one object per line, keyed by column
+// name, as JSON.stringify would write the row, except that binary values are
+// base64 strings. Streamed character LOBs are read to the end through the
+// cursor.
+class RowWriter
+{
+public:
+    // The cursor must have returned its first fetch, which describes the
+    // columns.
+    RowWriter(FileFormat format, Cursor& cursor);
+
+    // writeHeader appends the CSV header row to out; NDJSON has none.
+    void writeHeader(std::string& out);
+
+    // writeRow appends one row of cells to out.
+    void writeRow(const Cell* row, std::string& out);
+
+    // writeObject appends one row of cells to out as a JSON object, without
+    // the line break; the writer must be an NDJSON one.
+    void writeObject(const Cell* row, std::string& out);
+
+    // writeTrailer appends nothing; both formats end with their last row.
+    void writeTrailer(std::string& /*out*/) {}
+
+private:
+    FileFormat format;
+    Cursor& cursor;
+
+    // column names as they are written, the NDJSON ones as quoted keys
+    std::vector<std::string> names;
+
+    void writeCell(const Cell& cell, std::string& out);
+    void writeText(const char* s, size_t length, std::string& out);
+    void writeLob(NuoDB::Clob* lob, std::string& out);
+    void writeEscaped(const char* s, size_t length, std::string& out);
+};
+} // namespace NuoJs
+
+#endif
@@ -0,0 +1,350 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsStatement.h"
+#include "NuoJsConnection.h"
+#include "NuoJsErrMsg.h"
+#include "NuoJsResultSet.h"
+#include "NuoDB.h"
+
+#include "NuoJsData.h"
+
+namespace NuoJs
+{
+
+Nan::Persistent<Function> Statement::constructor;
+
+Statement::Statement()
+    : Nan::ObjectWrap()
+{
+    TRACE("Statement::Statement");
+}
+
+/* virtual */
+Statement::~Statement()
+{
+    TRACE("Statement::~Statement");
+}
+
+/* static */
+NAN_MODULE_INIT(Statement::init)
+{
+    TRACE("Statement::init");
+    Nan::HandleScope scope;
+
+    // prepare constructor template...
+    Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(Statement::newInstance);
+    tpl->SetClassName(Nan::New("Statement").ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+    // prototypes...
+    Nan::SetPrototypeMethod(tpl, "execute", execute);
+    Nan::SetPrototypeMethod(tpl, "close", close);
+
+    constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
+    Nan::Set(target, Nan::New<v8::String>("Statement").ToLocalChecked(),
+             Nan::GetFunction(tpl).ToLocalChecked());
+}
+
+/* static */
+NAN_METHOD(Statement::newInstance)
+{
+    TRACE("Statement::newInstance");
+    Nan::HandleScope scope;
+    if (info.IsConstructCall()) {
+        Statement* obj = new Statement();
+        obj->Wrap(info.This());
+        info.GetReturnValue().Set(info.This());
+    } else {
+        Local<Function> cons = Nan::New<Function>(constructor);
+        info.GetReturnValue().Set(Nan::NewInstance(cons).ToLocalChecked());
+    }
+}
+
+/* static */
+Local<Object> Statement::createFrom(Connection* connection, class NuoDB::PreparedStatement* statement,
+                                    Options options, std::string sql)
+{
+    TRACE("Statement::createFrom");
+    Nan::EscapableHandleScope scope;
+    Local<Function> cons = Nan::New<Function>(Statement::constructor);
+    Local<Object> obj = Nan::NewInstance(cons).ToLocalChecked();
+    Statement* self = Nan::ObjectWrap::Unwrap<Statement>(obj);
+    self->connection = connection;
+    // The last owner, either this statement or a result set it returned,
+    // closes the prepared statement. Once the connection is closed the
+    // statement has already been released along with it.
+    self->statement = std::shared_ptr<NuoDB::PreparedStatement>(statement,
+        [connection](NuoDB::PreparedStatement* statement) {
+            if (connection->isConnected()) {
+                try {
+                    statement->close();
+                } catch (NuoDB::SQLException& e) {
+                    // nothing more can be done with a statement that fails to close
+                }
+            }
+        });
+    self->options = options;
+    self->sql = sql;
+    return scope.Escape(obj);
+}
+
+bool Statement::isStatementOpen() const
+{
+    return statement != nullptr;
+}
+
+class StatementExecuteWorker : public Nan::AsyncWorker
+{
+  public:
+    StatementExecuteWorker(Nan::Callback* callback, Statement* self, Binds binds, Options options, std::string error)
+        : Nan::AsyncWorker(callback), self(self), binds(binds), options(options), error(error), hasResults(false)
+    {
+        TRACE("StatementExecuteWorker::StatementExecuteWorker");
+        data = manager.getData();
+        COUNT_ADD(data, EXECUTE_CNT);
+    }
+
+    virtual ~StatementExecuteWorker()
+    {
+        TRACE("StatementExecuteWorker::~StatementExecuteWorker");
+        COUNT_SUB(data, EXECUTE_CNT);
+        // workers are deleted on the main event loop thread
+        if (error.empty()) {
+            self->executing = false;
+        }
+    }
+
+    virtual void Execute()
+    {
+        TRACE("StatementExecuteWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(EXECUTE_QUE, QUE, data)
+            return;
+        }
+        try {
+          ADD_COUNT(EXECUTE_DO, DO, data)
+          SUBTRACT_COUNT(EXECUTE_DO, DO, data)
+          hasResults = self->doExecute(binds, options.getQueryTimeout(), options.getMaxRows());
+          if (hasResults && options.getFetchSize() > 0) {
+              cursor = Cursor::open(self->statement.get(), options.getFetchSize(), options);
+          }
+        } catch (std::exception& e) {
+            SetErrorMessage(e.what());
+            SUBTRACT_COUNT(EXECUTE_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("StatementExecuteWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Value> results = Nan::Undefined();
+        if (hasResults) {
+            results = ResultSet::createFrom(self->statement, options, std::move(cursor));
+        }
+        Local<Value> argv[] = {
+            Nan::Null(),
+            results
+        };
+        SUBTRACT_COUNT(EXECUTE_QUE, QUE, data)
+        callback->Call(2, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+  protected:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    Statement* self;
+    std::unique_ptr<Cursor> cursor;
+    Binds binds;
+    Options options;
+    std::string error;
+    bool hasResults;
+};
+
+/* static */
+NAN_METHOD(Statement::execute)
+{
+    TRACE("Statement::execute");
+    Nan::HandleScope scope;
+    std::string error;
+
+    Statement* self = Nan::ObjectWrap::Unwrap<Statement>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+
+    // binds (optional), track the index if they are present...
+    auto infoIdx = 0;
+    auto infoLen = info.Length();
+    Binds binds;
+    if (infoLen > 1 && info[infoIdx]->IsArray()) {
+        try {
+            getJsBinds(info[infoIdx++].As<Array>(), binds);
+        } catch (std::exception& e) {
+            error = e.what();
+        }
+    }
+
+    // query options (optional), overriding those given to prepare for
+    // this execution only
+    Options options(self->options);
+    if (infoLen > infoIdx && !info[infoIdx]->IsFunction()) {
+        try {
+            getJsonOptions(info[infoIdx++].As<Object>(), options);
+        } catch (std::exception& e) {
+            Nan::ThrowError(e.what());
+            return;
+        }
+    }
+
+    // A statement has one result at a time; executing again would close
+    // a result set that may still be read.
+    if (error.empty()) {
+        if (!self->isStatementOpen()) {
+            error = ErrMsg::get(ErrMsgType::errNoStatement);
+        } else if (self->executing || self->statement.use_count() > 1) {
+            error = ErrMsg::get(ErrMsgType::errStatementBusy);
+        } else if (!self->connection->isConnected()) {
+            error = ErrMsg::get(ErrMsgType::errConnectionClosed);
+        }
+    }
+
+    if (error.empty()) {
+        try {
+            self->connection->applyOptions(options);
+        } catch (std::exception& e) {
+            error = e.what();
+        }
+    }
+
+    if (error.empty()) {
+        self->executing = true;
+    }
+
+    Nan::Callback* callback = new Nan::Callback(info[infoIdx].As<Function>());
+
+    StatementExecuteWorker* worker = new StatementExecuteWorker(callback, self, binds, options, error);
+    worker->SaveToPersistent("nuodb:Statement", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(EXECUTE_QUE, QUE, worker->data)
+}
+
+// doExecute binds and executes the prepared statement. It runs on a worker
+// thread and must not touch V8.
+bool Statement::doExecute(const Binds& binds, uint32_t queryTimeout, uint32_t maxRows)
+{
+    if (!connection->isConnected()) {
+        std::string message = ErrMsg::get(ErrMsgType::errConnectionClosed);
+        throw std::runtime_error(message);
+    }
+
+    try {
+        statement->clearParameters();
+        statement->setQueryTimeout(queryTimeout);
+        statement->setMaxRows(maxRows);
+        bindStatement(statement.get(), binds);
+        return statement->execute();
+    } catch (NuoDB::SQLException& e) {
+        // Execution has failed, see if the failure should consider the connection dead
+        connection->markForFailure(e);
+        throw std::runtime_error(ErrMsg::get(e));
+    }
+}
+
+class StatementCloseWorker : public Nan::AsyncWorker
+{
+public:
+    StatementCloseWorker(Nan::Callback* callback, std::shared_ptr<NuoDB::PreparedStatement> statement,
+                         std::string error)
+        : Nan::AsyncWorker(callback), statement(std::move(statement)), error(error)
+    {
+        TRACE("StatementCloseWorker::StatementCloseWorker");
+        data = manager.getData();
+        COUNT_ADD(data, STATEMENTCLOSE_CNT);
+    }
+
+    virtual ~StatementCloseWorker()
+    {
+        TRACE("StatementCloseWorker::~StatementCloseWorker");
+        COUNT_SUB(data, STATEMENTCLOSE_CNT);
+    }
+
+    virtual void Execute()
+    {
+        TRACE("StatementCloseWorker::Execute");
+        if (!error.empty()) {
+            SetErrorMessage(error.c_str());
+            SUBTRACT_COUNT(STATEMENTCLOSE_QUE, QUE, data)
+            return;
+        }
+        try {
+          ADD_COUNT(STATEMENTCLOSE_DO, DO, data)
+          SUBTRACT_COUNT(STATEMENTCLOSE_DO, DO, data)
+          // closes the prepared statement, a round trip to the database,
+          // unless a result set still holds it
+          statement.reset();
+        } catch (std::exception& e) {
+            SetErrorMessage(e.what());
+            SUBTRACT_COUNT(STATEMENTCLOSE_QUE, QUE, data)
+        }
+    }
+
+    virtual void HandleOKCallback()
+    {
+        TRACE("StatementCloseWorker::HandleOKCallback");
+        Nan::HandleScope scope;
+        Local<Value> argv[] = {
+            Nan::Null()
+        };
+        SUBTRACT_COUNT(STATEMENTCLOSE_QUE, QUE, data)
+        callback->Call(1, argv, async_resource);
+    }
+
+    NuoJsData* data;
+
+private:
+    NuoJsDataManager& manager = NuoJsDataManager::getInstance(false);
+    std::shared_ptr<NuoDB::PreparedStatement> statement;
+    std::string error;
+};
+
+/* static */
+NAN_METHOD(Statement::close)
+{
+    TRACE("Statement::close");
+    Nan::HandleScope scope;
+
+    Statement* self = Nan::ObjectWrap::Unwrap<Statement>(info.This());
+
+    if (!info.Length() || !info[(info.Length() - 1)]->IsFunction()) {
+        Nan::ThrowError("connect arg count zero, or last arg is not a function");
+        return;
+    }
+    Nan::Callback* callback = new Nan::Callback(info[0].As<Function>());
+
+    // the statement is in use by the worker thread until execution completes.
+    // It is detached here, on the main thread that executes it, and only
+    // released by the worker.
+    std::string error;
+    std::shared_ptr<NuoDB::PreparedStatement> statement;
+    if (self->executing) {
+        error = ErrMsg::get(ErrMsgType::errStatementBusy);
+    } else if (!self->isStatementOpen()) {
+        error = ErrMsg::get(ErrMsgType::errNoStatement);
+    } else {
+        statement = std::move(self->statement);
+    }
+
+    StatementCloseWorker* worker = new StatementCloseWorker(callback, std::move(statement), error);
+    worker->SaveToPersistent("nuodb:Statement", info.This());
+    Nan::AsyncQueueWorker(worker);
+    ADD_COUNT(STATEMENTCLOSE_QUE, QUE, worker->data)
+}
+} // namespace NuoJs
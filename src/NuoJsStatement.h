@@ -0,0 +1,63 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_STATEMENT_H
+#define NUOJS_STATEMENT_H
+
+#include "NuoJsAddon.h"
+#include "NuoJsBinds.h"
+#include "NuoJsOptions.h"
+
+#include <memory>
+#include <string>
+
+namespace NuoJs
+{
+class Connection;
+
+// Statement is a statement prepared once by the application and executed
+// any number of times with different binds. Result sets returned by execute
+// share the underlying prepared statement, which is closed once both the
+// statement and its last result set are closed.
+class Statement : public Nan::ObjectWrap
+{
+public:
+    Statement();
+
+    virtual ~Statement();
+
+    static NAN_MODULE_INIT(init);
+
+    static NAN_METHOD(newInstance);
+
+    static Local<Object> createFrom(Connection* connection, class NuoDB::PreparedStatement* statement,
+                                    Options options, std::string sql);
+
+    static Nan::Persistent<Function> constructor;
+
+private:
+
+    static NAN_METHOD(execute);
+    friend class StatementExecuteWorker;
+    bool doExecute(const Binds& binds, uint32_t queryTimeout, uint32_t maxRows);
+
+    static NAN_METHOD(close);
+    friend class StatementCloseWorker;
+
+    bool isStatementOpen() const;
+
+    // set while an execution is queued or running
+    bool executing = false;
+
+    Connection* connection = nullptr;
+    std::shared_ptr<NuoDB::PreparedStatement> statement;
+
+    // options given to prepare, the defaults of every execution
+    Options options;
+    std::string sql;
+};
+} // namespace NuoJs
+
+#endif
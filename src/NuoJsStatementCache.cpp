@@ -0,0 +1,132 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#include "NuoJsStatementCache.h"
+#include "NuoJsAddon.h"
+
+#include "NuoJsData.h"
+
+namespace NuoJs
+{
+uint32_t StatementCache::Default_Capacity = 64;
+
+StatementCache::StatementCache(uint32_t capacity)
+    : capacity(capacity)
+{
+    TRACE("StatementCache::StatementCache");
+}
+
+StatementCache::~StatementCache()
+{
+    TRACE("StatementCache::~StatementCache");
+    // only a cache whose connection was never closed still holds statements
+    close();
+}
+
+NuoDB::PreparedStatement* StatementCache::acquire(const std::string& sql)
+{
+    TRACE("StatementCache::acquire");
+    NuoJsData* data = NuoJsDataManager::getInstance(false).getData();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto found = index.find(sql);
+    if (found == index.end()) {
+        COUNT_TOTAL(data, STMTCACHE_MISS);
+        return nullptr;
+    }
+    NuoDB::PreparedStatement* statement = found->second->second;
+    // erase the index entry first, its key refers to the list node
+    auto entry = found->second;
+    index.erase(found);
+    entries.erase(entry);
+    COUNT_SUB(data, STMTCACHE_SIZE);
+    COUNT_TOTAL(data, STMTCACHE_HIT);
+    return statement;
+}
+
+void StatementCache::release(const std::string& sql, NuoDB::PreparedStatement* statement)
+{
+    TRACE("StatementCache::release");
+    if (statement == nullptr) {
+        return;
+    }
+    NuoJsData* data = NuoJsDataManager::getInstance(false).getData();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // an identical statement may have been released by a concurrent
+    // execution of the same SQL; only one copy is kept.
+    if (capacity == 0 || index.find(sql) != index.end()) {
+        discard(statement);
+        return;
+    }
+
+    try {
+        statement->clearParameters();
+        statement->setQueryTimeout(0);
+        statement->setMaxRows(0);
+    } catch (NuoDB::SQLException& e) {
+        discard(statement);
+        return;
+    }
+
+    if (entries.size() >= capacity) {
+        evict();
+    }
+    entries.emplace_front(sql, statement);
+    index.emplace(entries.front().first, entries.begin());
+    COUNT_ADD(data, STMTCACHE_SIZE);
+}
+
+void StatementCache::discard(NuoDB::PreparedStatement* statement)
+{
+    TRACE("StatementCache::discard");
+    if (statement == nullptr) {
+        return;
+    }
+    try {
+        statement->close();
+    } catch (NuoDB::SQLException& e) {
+        // the statement is unusable either way
+    }
+}
+
+void StatementCache::evict()
+{
+    TRACE("StatementCache::evict");
+    NuoJsData* data = NuoJsDataManager::getInstance(false).getData();
+    Entry& oldest = entries.back();
+    index.erase(oldest.first);
+    discard(oldest.second);
+    entries.pop_back();
+    COUNT_SUB(data, STMTCACHE_SIZE);
+    COUNT_TOTAL(data, STMTCACHE_EVICT);
+}
+
+void StatementCache::close()
+{
+    TRACE("StatementCache::close");
+    NuoJsData* data = NuoJsDataManager::getInstance(false).getData();
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = 0;
+    index.clear();
+    for (auto& entry : entries) {
+        discard(entry.second);
+        COUNT_SUB(data, STMTCACHE_SIZE);
+    }
+    entries.clear();
+}
+
+size_t StatementCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+uint32_t StatementCache::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+}
@@ -0,0 +1,79 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+#ifndef NUOJS_STATEMENTCACHE_H
+#define NUOJS_STATEMENTCACHE_H
+
+#include "NuoDB.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace NuoJs
+{
+// StatementCache is a bounded, least-recently-used cache of idle prepared
+// statements belonging to a single connection, keyed by SQL text.
+//
+// A statement is checked out of the cache by acquire() and handed back by
+// release() once its execution (and any result set) is finished, so two
+// concurrent executions of the same SQL never share a statement. Released
+// statements have their parameters cleared and any query timeout reset
+// before they are made available again. When the cache is full the least
+// recently used statement is closed.
+//
+// Workers acquire and release statements from the libuv thread pool, so all
+// access to the cache is serialized by a mutex.
+class StatementCache
+{
+public:
+    // Default capacity of each connection's cache; may be overridden with
+    // the NUODB_NODE_STATEMENT_CACHE_SIZE environment variable. A capacity
+    // of zero disables caching.
+    static uint32_t Default_Capacity;
+
+    explicit StatementCache(uint32_t capacity);
+    ~StatementCache();
+
+    // acquire removes and returns the idle statement cached for sql, or
+    // returns nullptr if there is none.
+    NuoDB::PreparedStatement* acquire(const std::string& sql);
+
+    // release clears the statement parameters and returns the statement to
+    // the cache, closing it instead if it cannot be cached.
+    void release(const std::string& sql, NuoDB::PreparedStatement* statement);
+
+    // discard closes a statement that must not be reused, e.g. after its
+    // execution failed.
+    void discard(NuoDB::PreparedStatement* statement);
+
+    // close closes every idle statement and disables the cache, so that
+    // statements released afterwards are closed rather than cached. It must
+    // be called before the owning connection is closed.
+    void close();
+
+    size_t size() const;
+    uint32_t getCapacity() const;
+
+private:
+    typedef std::pair<std::string, NuoDB::PreparedStatement*> Entry;
+
+    // evict closes the least recently used statement; mutex must be held.
+    void evict();
+
+    mutable std::mutex mutex;
+    uint32_t capacity;
+
+    // most recently used entries are at the front of the list; the index
+    // keys are views onto the SQL text held by the list nodes.
+    std::list<Entry> entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+};
+}
+
+#endif
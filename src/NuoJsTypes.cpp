@@ -30,6 +30,8 @@ int typeOf(Local<Value> v)
         return ES_DATE;
     } else if (v->IsObject()) {
         return ES_OBJECT;
+    } else if (v->IsBigInt()) {
+        return ES_BIGINT;
     } else if (v->IsBoolean()) {
         return ES_BOOLEAN;
     } else if (v->IsUndefined()) {
@@ -142,6 +144,10 @@ int Type::fromEsType(int type)
             return NUOSQL_DATE;
             break;
 
+        case EsType::ES_BIGINT:
+            return NUOSQL_BIGINT;
+            break;
+
         default:
             return NUOSQL_UNDEFINED;
     }
@@ -33,6 +33,7 @@ enum EsType
     ES_DATE,
     ES_FUNCTION,
     ES_EXTERNAL,
+    ES_BIGINT,
 };
 
 int typeOf(Local<Value> value);
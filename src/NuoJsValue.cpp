@@ -11,30 +11,9 @@
 namespace NuoJs
 {
 SqlValue::SqlValue()
+    : sqlType(NuoDB::NUOSQL_NULL)
 {}
 
-SqlValue::SqlValue(const SqlValue& rhs)
-    : name(rhs.name), sqlType(rhs.sqlType), u(rhs.u), s(rhs.s)
-{}
-
-std::string SqlValue::getName() const
-{
-    return name;
-}
-void SqlValue::setName(std::string s)
-{
-    name = s;
-}
-
-std::string SqlValue::getTable() const
-{
-    return table;
-}
-void SqlValue::setTable(std::string s)
-{
-    table = s;
-}
-
 int SqlValue::getSqlType() const
 {
     return sqlType;
@@ -107,13 +86,13 @@ void SqlValue::setLong(int64_t value)
     u.i64 = value;
 }
 
-std::string SqlValue::getString() const
+const std::string& SqlValue::getString() const
 {
     return s;
 }
 void SqlValue::setString(std::string value)
 {
-    s = value;
+    s = std::move(value);
 }
 
 std::string int64ToString(int64_t v)
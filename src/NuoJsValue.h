@@ -14,13 +14,6 @@ class SqlValue
 {
 public:
     SqlValue();
-    SqlValue(const SqlValue& rhs);
-
-    std::string getName() const;
-    void setName(std::string);
-
-    std::string getTable() const;
-    void setTable(std::string);
 
     int getSqlType() const;
     void setSqlType(int sqlType);
@@ -46,13 +39,10 @@ public:
     int64_t getLong() const;
     void setLong(int64_t value);
 
-    std::string getString() const;
+    const std::string& getString() const;
     void setString(std::string value);
 
 private:
-    std::string name;
-    std::string table;
-
     int sqlType;
 
     union
@@ -0,0 +1,76 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+const getCounter = (name) => {
+  const snapshot = JSON.parse(Driver.getAsyncJSON())[0];
+  return snapshot.counters.find((counter) => counter.name === name);
+};
+
+describe('22. Test Statement Cache', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+  });
+
+  it('22.1 reuses prepared statements for repeated SQL', async () => {
+    const sql = 'SELECT ? AS VALUE FROM DUAL';
+    const hitsBefore = getCounter('STMTCACHE_HIT').total;
+    for (let i = 0; i < 10; i++) {
+      const results = await connection.execute(sql, [i]);
+      const rows = await results.getRows();
+      rows.should.be.eql([{ VALUE: i }]);
+      await results.close();
+    }
+    (getCounter('STMTCACHE_HIT').total - hitsBefore).should.be.aboveOrEqual(9);
+  });
+
+  it('22.2 clears parameters of a reused statement', async () => {
+    const sql = 'SELECT COALESCE(?, \'none\') AS VALUE FROM DUAL';
+    let results = await connection.execute(sql, ['first']);
+    (await results.getRows()).should.be.eql([{ VALUE: 'first' }]);
+    await results.close();
+    results = await connection.execute(sql, [null]);
+    (await results.getRows()).should.be.eql([{ VALUE: 'none' }]);
+    await results.close();
+  });
+
+  it('22.3 releases statements of unread result sets', async () => {
+    const sql = 'SELECT 1 AS VALUE FROM DUAL';
+    let results = await connection.execute(sql);
+    await results.close();
+    results = await connection.execute(sql);
+    (await results.getRows()).should.be.eql([{ VALUE: 1 }]);
+    await results.close();
+  });
+
+  it('22.4 exports statement cache counters', () => {
+    should.exist(getCounter('STMTCACHE_SIZE'));
+    should.exist(getCounter('STMTCACHE_HIT'));
+    should.exist(getCounter('STMTCACHE_MISS'));
+    should.exist(getCounter('STMTCACHE_EVICT'));
+  });
+});
@@ -0,0 +1,104 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('23. Test Prepared Statement', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS PREPARED_STATEMENT_TEST');
+    await connection.execute('CREATE TABLE PREPARED_STATEMENT_TEST (ID INTEGER, NAME STRING)');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS PREPARED_STATEMENT_TEST');
+    await connection.close();
+  });
+
+  it('23.1 executes a prepared insert with different binds', async () => {
+    const statement = await connection.prepare('INSERT INTO PREPARED_STATEMENT_TEST VALUES (?, ?)');
+    try {
+      for (let i = 0; i < 5; i++) {
+        const results = await statement.execute([i, 'name' + i]);
+        should.not.exist(results);
+      }
+    } finally {
+      await statement.close();
+    }
+    const results = await connection.execute('SELECT COUNT(*) AS CNT FROM PREPARED_STATEMENT_TEST');
+    (await results.getRows()).should.be.eql([{ CNT: 5 }]);
+    await results.close();
+  });
+
+  it('23.2 executes a prepared query with different binds', async () => {
+    const statement = await connection.prepare('SELECT NAME FROM PREPARED_STATEMENT_TEST WHERE ID = ?');
+    try {
+      for (let i = 0; i < 5; i++) {
+        const results = await statement.execute([i]);
+        (await results.getRows()).should.be.eql([{ NAME: 'name' + i }]);
+        await results.close();
+      }
+    } finally {
+      await statement.close();
+    }
+  });
+
+  it('23.3 applies prepare and per-execution options', async () => {
+    const statement = await connection.prepare('SELECT ID FROM PREPARED_STATEMENT_TEST WHERE ID = ?', { rowMode: RowMode.ROWS_AS_ARRAY });
+    try {
+      let results = await statement.execute([1]);
+      (await results.getRows()).should.be.eql([[1]]);
+      await results.close();
+      results = await statement.execute([1], { rowMode: RowMode.ROWS_AS_OBJECT });
+      (await results.getRows()).should.be.eql([{ ID: 1 }]);
+      await results.close();
+    } finally {
+      await statement.close();
+    }
+  });
+
+  it('23.4 rejects execution while a result set is open', async () => {
+    const statement = await connection.prepare('SELECT ID FROM PREPARED_STATEMENT_TEST');
+    const results = await statement.execute();
+    try {
+      await statement.execute().should.be.rejectedWith(/open result set/);
+    } finally {
+      await results.close();
+      await statement.close();
+    }
+  });
+
+  it('23.5 keeps the result set readable after the statement is closed', async () => {
+    const statement = await connection.prepare('SELECT ID FROM PREPARED_STATEMENT_TEST ORDER BY ID');
+    const results = await statement.execute();
+    await statement.close();
+    (await results.getRows()).length.should.be.eql(5);
+    await results.close();
+  });
+
+  it('23.6 rejects a closed statement', async () => {
+    const statement = await connection.prepare('SELECT 1 FROM DUAL');
+    await statement.close();
+    await statement.execute().should.be.rejectedWith(/statement is not open/);
+    await statement.close().should.be.rejectedWith(/statement is not open/);
+  });
+});
@@ -0,0 +1,69 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('24. Test Batch Execution', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS EXECUTE_BATCH_TEST');
+    await connection.execute('CREATE TABLE EXECUTE_BATCH_TEST (ID INTEGER, NAME STRING, PRICE DOUBLE)');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS EXECUTE_BATCH_TEST');
+    await connection.close();
+  });
+
+  it('24.1 inserts all rows and returns the update counts', async () => {
+    const rows = [];
+    for (let i = 0; i < 1000; i++) {
+      rows.push([i, 'name' + i, i / 4]);
+    }
+    const counts = await connection.executeBatch('INSERT INTO EXECUTE_BATCH_TEST VALUES (?, ?, ?)', rows);
+    counts.length.should.be.eql(1000);
+    counts.forEach((count) => count.should.be.eql(1));
+
+    const results = await connection.execute('SELECT COUNT(*) AS CNT, SUM(PRICE) AS TOTAL FROM EXECUTE_BATCH_TEST');
+    const found = await results.getRows();
+    await results.close();
+    found[0].CNT.should.be.eql(1000);
+  });
+
+  it('24.2 returns the update count of each row', async () => {
+    const counts = await connection.executeBatch('UPDATE EXECUTE_BATCH_TEST SET NAME = ? WHERE ID < ?', [['low', 10], ['none', -1]]);
+    counts.should.be.eql([10, 0]);
+  });
+
+  it('24.3 accepts an empty batch', async () => {
+    const counts = await connection.executeBatch('INSERT INTO EXECUTE_BATCH_TEST VALUES (?, ?, ?)', []);
+    counts.should.be.eql([]);
+  });
+
+  it('24.4 rejects rows that are not arrays', async () => {
+    (() => connection._executeBatch('INSERT INTO EXECUTE_BATCH_TEST VALUES (?, ?, ?)', [1, 2, 3], () => {})).should.throw(/invalid value for parameter 1/);
+  });
+
+  it('24.5 reports SQL errors', async () => {
+    await connection.executeBatch('INSERT INTO NO_SUCH_TABLE VALUES (?)', [[1]]).should.be.rejected();
+  });
+});
@@ -0,0 +1,80 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('25. Test Columnar Batch Execution', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS EXECUTE_COLUMNS_TEST');
+    await connection.execute('CREATE TABLE EXECUTE_COLUMNS_TEST (ID INTEGER, NAME STRING, VALUE DOUBLE, BIG BIGINT)');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS EXECUTE_COLUMNS_TEST');
+    await connection.close();
+  });
+
+  it('25.1 inserts rows from typed arrays and string arrays', async () => {
+    const count = 500;
+    const ids = new Int32Array(count);
+    const names = new Array(count);
+    const values = new Float64Array(count);
+    const bigs = new BigInt64Array(count);
+    for (let i = 0; i < count; i++) {
+      ids[i] = i;
+      names[i] = i % 10 === 0 ? null : 'name' + i;
+      values[i] = i * 1.5;
+      bigs[i] = BigInt(i) * 10000000000n;
+    }
+    const updated = await connection.executeColumns('INSERT INTO EXECUTE_COLUMNS_TEST VALUES (?, ?, ?, ?)', [ids, names, values, bigs]);
+    updated.should.be.eql(count);
+
+    const results = await connection.execute('SELECT ID, NAME, VALUE, BIG FROM EXECUTE_COLUMNS_TEST WHERE ID IN (10, 11) ORDER BY ID');
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([
+      { ID: 10, NAME: null, VALUE: 15, BIG: '100000000000' },
+      { ID: 11, NAME: 'name11', VALUE: 16.5, BIG: '110000000000' },
+    ]);
+  });
+
+  it('25.2 reads typed arrays at an offset into their buffer', async () => {
+    const buffer = new Int16Array([-1, 1000, 1001, -1]);
+    const ids = new Int16Array(buffer.buffer, 2, 2);
+    const updated = await connection.executeColumns('INSERT INTO EXECUTE_COLUMNS_TEST (ID) VALUES (?)', [ids]);
+    updated.should.be.eql(2);
+    const results = await connection.execute('SELECT ID FROM EXECUTE_COLUMNS_TEST WHERE ID >= 1000 ORDER BY ID');
+    (await results.getRows()).should.be.eql([{ ID: 1000 }, { ID: 1001 }]);
+    await results.close();
+  });
+
+  it('25.3 rejects columns of different lengths', async () => {
+    await connection.executeColumns('INSERT INTO EXECUTE_COLUMNS_TEST (ID, VALUE) VALUES (?, ?)',
+      [new Int32Array(2), new Float64Array(3)]).should.be.rejectedWith(/invalid value for parameter 1/);
+  });
+
+  it('25.4 rejects columns that are not arrays', async () => {
+    await connection.executeColumns('INSERT INTO EXECUTE_COLUMNS_TEST (ID) VALUES (?)', [5])
+      .should.be.rejectedWith(/invalid value for parameter 0/);
+  });
+});
@@ -0,0 +1,96 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+const getCounter = (name) => {
+  const snapshot = JSON.parse(Driver.getAsyncJSON())[0];
+  return snapshot.counters.find((counter) => counter.name === name);
+};
+
+describe('26. Test Fetch Size', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS FETCH_SIZE_TEST');
+    await connection.execute('CREATE TABLE FETCH_SIZE_TEST (ID INTEGER)');
+    await connection.executeBatch('INSERT INTO FETCH_SIZE_TEST VALUES (?)', [[1], [2], [3], [4], [5]]);
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS FETCH_SIZE_TEST');
+    await connection.close();
+  });
+
+  it('26.1 returns a point lookup without another worker', async () => {
+    const getRowsBefore = getCounter('GETROWS_CNT').total;
+    const results = await connection.execute('SELECT ID FROM FETCH_SIZE_TEST WHERE ID = ?', [3], { fetchSize: 10 });
+    (await results.getRows()).should.be.eql([{ ID: 3 }]);
+    await results.close();
+    getCounter('GETROWS_CNT').total.should.be.eql(getRowsBefore);
+  });
+
+  it('26.2 continues fetching past the first batch', async () => {
+    const results = await connection.execute('SELECT ID FROM FETCH_SIZE_TEST ORDER BY ID', { fetchSize: 2 });
+    (await results.getRows(1)).should.be.eql([{ ID: 1 }]);
+    (await results.getRows(2)).should.be.eql([{ ID: 2 }, { ID: 3 }]);
+    (await results.getRows()).should.be.eql([{ ID: 4 }, { ID: 5 }]);
+    (await results.getRows()).should.be.eql([]);
+    await results.close();
+  });
+
+  it('26.3 applies to prepared statements', async () => {
+    const statement = await connection.prepare('SELECT ID FROM FETCH_SIZE_TEST WHERE ID > ? ORDER BY ID', { fetchSize: 100 });
+    try {
+      const results = await statement.execute([3]);
+      (await results.getRows()).should.be.eql([{ ID: 4 }, { ID: 5 }]);
+      await results.close();
+    } finally {
+      await statement.close();
+    }
+  });
+
+  it('26.4 reads large strings across buffered batches', async () => {
+    const large = 'x'.repeat(40000);
+    const results = await connection.execute(
+      'SELECT ?||CAST(F1.ID AS STRING) AS S, F2.ID AS N FROM FETCH_SIZE_TEST F1, FETCH_SIZE_TEST F2, FETCH_SIZE_TEST F3, FETCH_SIZE_TEST F4, FETCH_SIZE_TEST F5 ORDER BY 1, 2',
+      [large], { fetchSize: 1500 });
+    let total = 0;
+    for (;;) {
+      const rows = await results.getRows(700);
+      rows.forEach((row) => {
+        row.S.length.should.be.eql(large.length + 1);
+        row.S.startsWith(large).should.be.true();
+      });
+      total += rows.length;
+      if (rows.length < 700) {
+        break;
+      }
+    }
+    await results.close();
+    total.should.be.eql(3125);
+  });
+
+  it('26.5 closes a result set that was never read', async () => {
+    const results = await connection.execute('SELECT ID FROM FETCH_SIZE_TEST', { fetchSize: 1 });
+    await results.close();
+  });
+});
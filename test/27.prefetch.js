@@ -0,0 +1,82 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+const getCounter = (name) => {
+  const snapshot = JSON.parse(Driver.getAsyncJSON())[0];
+  return snapshot.counters.find((counter) => counter.name === name);
+};
+
+const ROW_COUNT = 1000;
+
+describe('27. Test Result Set Read-Ahead', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS PREFETCH_TEST');
+    await connection.execute('CREATE TABLE PREFETCH_TEST (ID INTEGER, NAME STRING)');
+    const ids = new Int32Array(ROW_COUNT).map((_, i) => i);
+    const names = Array.from(ids, (i) => 'name' + i);
+    await connection.executeColumns('INSERT INTO PREFETCH_TEST VALUES (?, ?)', [ids, names]);
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS PREFETCH_TEST');
+    await connection.close();
+  });
+
+  const readAll = async (results, batchSize) => {
+    const rows = [];
+    for (;;) {
+      const batch = await results.getRows(batchSize);
+      rows.push(...batch);
+      if (batch.length < batchSize) {
+        return rows;
+      }
+      // give the read-ahead time to run while this batch is processed
+      await new Promise((resolve) => setImmediate(resolve));
+    }
+  };
+
+  it('27.1 returns every row in order while reading ahead', async () => {
+    const prefetchBefore = getCounter('PREFETCH_CNT').total;
+    const results = await connection.execute('SELECT ID, NAME FROM PREFETCH_TEST ORDER BY ID', { prefetchDepth: 2 });
+    const rows = await readAll(results, 100);
+    await results.close();
+    rows.length.should.be.eql(ROW_COUNT);
+    rows.forEach((row, i) => row.should.be.eql({ ID: i, NAME: 'name' + i }));
+    getCounter('PREFETCH_CNT').total.should.be.above(prefetchBefore);
+  });
+
+  it('27.2 honors the memory cap', async () => {
+    const results = await connection.execute('SELECT ID, NAME FROM PREFETCH_TEST ORDER BY ID', { prefetchDepth: 10, prefetchMaxBytes: 1 });
+    const rows = await readAll(results, 50);
+    await results.close();
+    rows.length.should.be.eql(ROW_COUNT);
+  });
+
+  it('27.3 closes a result set while reading ahead', async () => {
+    const results = await connection.execute('SELECT ID FROM PREFETCH_TEST', { prefetchDepth: 4 });
+    (await results.getRows(10)).length.should.be.eql(10);
+    await results.close();
+  });
+});
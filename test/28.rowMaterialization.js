@@ -0,0 +1,95 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('28. Test Row Materialization', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+  });
+
+  const wideSql = 'SELECT 1 AS A, \'b\' AS B, NULL AS C, 4.5 AS D, TRUE AS E FROM DUAL';
+
+  it('28.1 builds objects with keys in column order', async () => {
+    const results = await connection.execute(wideSql);
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([{ A: 1, B: 'b', C: null, D: 4.5, E: true }]);
+    Object.keys(rows[0]).should.be.eql(['A', 'B', 'C', 'D', 'E']);
+  });
+
+  it('28.2 builds arrays of the column values', async () => {
+    const results = await connection.execute(wideSql, { rowMode: RowMode.ROWS_AS_ARRAY });
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([[1, 'b', null, 4.5, true]]);
+  });
+
+  it('28.3 keeps the last of duplicate column names', async () => {
+    const results = await connection.execute('SELECT 1 AS X, 2 AS X FROM DUAL');
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([{ X: 2 }]);
+  });
+
+  it('28.4 reuses keys across batches of a result set', async () => {
+    const results = await connection.execute('SELECT 1 AS ONE, 2 AS TWO FROM SYSTEM.TABLES');
+    const first = await results.getRows(1);
+    const rest = await results.getRows();
+    await results.close();
+    first.concat(rest).forEach((row) => row.should.be.eql({ ONE: 1, TWO: 2 }));
+  });
+
+  it('28.5 returns ASCII, non-ASCII and large strings intact', async () => {
+    const large = 'x'.repeat(100 * 1024);
+    const largeUnicode = 'é'.repeat(50 * 1024);
+    const results = await connection.execute('SELECT ? AS A, ? AS U, ? AS L, ? AS LU FROM DUAL',
+      ['code-123', 'naïve ☃', large, largeUnicode]);
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([{ A: 'code-123', U: 'naïve ☃', L: large, LU: largeUnicode }]);
+  });
+
+  it('28.6 returns repeated and distinct strings across batches', async () => {
+    const statuses = ['OPEN', 'CLOSED', 'ÉTÉ'];
+    const expected = [];
+    for (let i = 0; i < 3000; i++) {
+      expected.push({ ID: i, STATUS: statuses[i % 3], NAME: 'name' + i });
+    }
+    await connection.execute('DROP TABLE IF EXISTS DICTIONARY_TEST');
+    await connection.execute('CREATE TABLE DICTIONARY_TEST (ID INTEGER, STATUS STRING, NAME STRING)');
+    try {
+      await connection.executeBatch('INSERT INTO DICTIONARY_TEST VALUES (?, ?, ?)',
+        expected.map((row) => [row.ID, row.STATUS, row.NAME]));
+      const results = await connection.execute('SELECT ID, STATUS, NAME FROM DICTIONARY_TEST ORDER BY ID');
+      const rows = await results.getRows();
+      await results.close();
+      rows.should.be.eql(expected);
+    } finally {
+      await connection.execute('DROP TABLE IF EXISTS DICTIONARY_TEST');
+    }
+  });
+});
@@ -0,0 +1,104 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('29. Test Date Codec', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+  });
+
+  const selectOne = async (sql, binds) => {
+    const results = await connection.execute(sql, binds || []);
+    const rows = await results.getRows();
+    await results.close();
+    return rows[0];
+  };
+
+  it('29.1 reads dates as UTC midnight', async () => {
+    const row = await selectOne('SELECT CAST(\'2013-09-08\' AS DATE) AS D FROM DUAL');
+    row.D.should.be.instanceOf(Date);
+    row.D.getTime().should.be.eql(new Date('2013-09-08').getTime());
+  });
+
+  it('29.2 reads time stamps as local time, truncated to milliseconds', async () => {
+    const row = await selectOne('SELECT CAST(\'2015-07-23 23:00:00.789123\' AS TIMESTAMP) AS T FROM DUAL');
+    row.T.getTime().should.be.eql(new Date('2015-07-23 23:00:00.789123').getTime());
+  });
+
+  it('29.3 reads times as local time on the epoch day', async () => {
+    const row = await selectOne('SELECT CAST(\'23:11:00\' AS TIME) AS T FROM DUAL');
+    row.T.getTime().should.be.eql(new Date('1970-01-01T23:11:00').getTime());
+  });
+
+  it('29.4 reads time stamps either side of daylight saving changes', async () => {
+    const stamps = ['2021-03-14 02:30:00', '2021-03-28 02:30:00', '2021-10-31 02:30:00', '2021-11-07 01:30:00'];
+    for (const stamp of stamps) {
+      const row = await selectOne(`SELECT CAST('${stamp}' AS TIMESTAMP) AS T FROM DUAL`);
+      row.T.getTime().should.be.eql(new Date(stamp).getTime());
+    }
+  });
+
+  it('29.5 round trips bound dates', async () => {
+    const dates = [new Date(2000, 0, 1), new Date(2020, 6, 4, 12, 30, 15, 250), new Date(1960, 11, 31, 23, 59, 59, 999)];
+    for (const date of dates) {
+      const row = await selectOne('SELECT CAST(? AS TIMESTAMP) AS T FROM DUAL', [date]);
+      row.T.getTime().should.be.eql(date.getTime());
+    }
+  });
+
+  it('29.6 reads null dates', async () => {
+    const row = await selectOne('SELECT CAST(NULL AS TIMESTAMP) AS T FROM DUAL');
+    should(row.T).be.null();
+  });
+
+  it('29.7 follows a change of local time zone', async () => {
+    const zone = process.env.TZ;
+    const stamps = ['2021-03-14 01:59:59', '2021-03-14 03:00:00', '2021-11-07 01:30:00', '2021-11-07 02:00:00'];
+    try {
+      for (const tz of ['America/New_York', 'Asia/Kolkata', 'Australia/Lord_Howe']) {
+        process.env.TZ = tz;
+        const zoned = await driver.connect(DBConnect);
+        try {
+          for (const stamp of stamps) {
+            const results = await zoned.execute(`SELECT CAST('${stamp}' AS TIMESTAMP) AS T FROM DUAL`);
+            const rows = await results.getRows();
+            await results.close();
+            rows[0].T.getTime().should.be.eql(new Date(stamp).getTime());
+          }
+        } finally {
+          await zoned.close();
+        }
+      }
+    } finally {
+      if (zone === undefined) {
+        delete process.env.TZ;
+      } else {
+        process.env.TZ = zone;
+      }
+    }
+  });
+});
@@ -0,0 +1,72 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('30. Test BigInt', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS BIGINT_TEST');
+    await connection.execute('CREATE TABLE BIGINT_TEST (ID BIGINT)');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS BIGINT_TEST');
+    await connection.close();
+  });
+
+  const selectAll = async (options) => {
+    const results = await connection.execute('SELECT ID FROM BIGINT_TEST ORDER BY ID', options);
+    const rows = await results.getRows();
+    await results.close();
+    return rows;
+  };
+
+  it('30.1 binds BigInt values as 64-bit integers', async () => {
+    await connection.execute('INSERT INTO BIGINT_TEST VALUES (?)', [9223372036854775807n]);
+    await connection.execute('INSERT INTO BIGINT_TEST VALUES (?)', [-9223372036854775808n]);
+    await connection.execute('INSERT INTO BIGINT_TEST VALUES (?)', [42n]);
+  });
+
+  it('30.2 returns numbers and strings by default', async () => {
+    const rows = await selectAll();
+    rows.should.be.eql([{ ID: '-9223372036854775808' }, { ID: 42 }, { ID: '9223372036854775807' }]);
+  });
+
+  it('30.3 returns BigInt values with the bigint option', async () => {
+    const rows = await selectAll({ bigint: true });
+    rows.should.be.eql([{ ID: -9223372036854775808n }, { ID: 42n }, { ID: 9223372036854775807n }]);
+  });
+
+  it('30.4 returns BigInt values in array rows', async () => {
+    const rows = await selectAll({ bigint: true, rowMode: RowMode.ROWS_AS_ARRAY });
+    rows.should.be.eql([[-9223372036854775808n], [42n], [9223372036854775807n]]);
+  });
+
+  it('30.5 binds BigInt values beyond 64 bits as strings', async () => {
+    const results = await connection.execute('SELECT CAST(? AS STRING) AS V FROM DUAL', [18446744073709551616n]);
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([{ V: '18446744073709551616' }]);
+    should.exist(rows);
+  });
+});
@@ -0,0 +1,77 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('31. Test Binary Values', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS BINARY_TEST');
+    await connection.execute('CREATE TABLE BINARY_TEST (ID INTEGER, B BLOB, V VARBINARY(16))');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS BINARY_TEST');
+    await connection.close();
+  });
+
+  const select = async (sql, binds, options) => {
+    const results = await connection.execute(sql, binds, options);
+    const rows = await results.getRows();
+    await results.close();
+    return rows;
+  };
+
+  it('31.1 round trips bytes with embedded nulls', async () => {
+    const bytes = Buffer.from([0, 1, 2, 0, 255, 0]);
+    await connection.execute('INSERT INTO BINARY_TEST VALUES (1, ?, ?)', [bytes, bytes]);
+    const rows = await select('SELECT B, V FROM BINARY_TEST WHERE ID = 1', []);
+    Buffer.isBuffer(rows[0].B).should.be.true();
+    Buffer.isBuffer(rows[0].V).should.be.true();
+    rows[0].B.equals(bytes).should.be.true();
+    rows[0].V.equals(bytes).should.be.true();
+  });
+
+  it('31.2 round trips large blobs', async () => {
+    const bytes = Buffer.alloc(1024 * 1024);
+    for (let i = 0; i < bytes.length; i++) {
+      bytes[i] = i % 251;
+    }
+    await connection.execute('INSERT INTO BINARY_TEST (ID, B) VALUES (2, ?)', [bytes]);
+    const rows = await select('SELECT B FROM BINARY_TEST WHERE ID = 2', [], { rowMode: RowMode.ROWS_AS_ARRAY });
+    rows[0][0].equals(bytes).should.be.true();
+  });
+
+  it('31.3 binds typed arrays as their bytes', async () => {
+    const values = new Uint16Array([1, 2, 3]);
+    await connection.execute('INSERT INTO BINARY_TEST (ID, B) VALUES (3, ?)', [values]);
+    const rows = await select('SELECT B FROM BINARY_TEST WHERE ID = 3', []);
+    rows[0].B.equals(Buffer.from(values.buffer)).should.be.true();
+  });
+
+  it('31.4 reads empty and null binary values', async () => {
+    await connection.execute('INSERT INTO BINARY_TEST VALUES (4, ?, NULL)', [Buffer.alloc(0)]);
+    const rows = await select('SELECT B, V FROM BINARY_TEST WHERE ID = 4', []);
+    rows[0].B.length.should.be.eql(0);
+    should(rows[0].V).be.null();
+  });
+});
@@ -0,0 +1,83 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('32. Test LOB Streaming', () => {
+
+  var driver = null;
+  var connection = null;
+
+  const small = 'small document';
+  const large = 'große Dokumente '.repeat(64 * 1024);
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS LOB_TEST');
+    await connection.execute('CREATE TABLE LOB_TEST (ID INTEGER, DOC CLOB)');
+    await connection.execute('INSERT INTO LOB_TEST VALUES (1, ?)', [small]);
+    await connection.execute('INSERT INTO LOB_TEST VALUES (2, ?)', [large]);
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS LOB_TEST');
+    await connection.close();
+  });
+
+  it('32.1 returns strings by default', async () => {
+    const results = await connection.execute('SELECT DOC FROM LOB_TEST ORDER BY ID');
+    const rows = await results.getRows();
+    await results.close();
+    rows.should.be.eql([{ DOC: small }, { DOC: large }]);
+  });
+
+  it('32.2 returns values past the threshold as LOBs', async () => {
+    const results = await connection.execute('SELECT DOC FROM LOB_TEST ORDER BY ID', { lobStreamThreshold: 1024 });
+    const rows = await results.getRows();
+    rows[0].DOC.should.be.eql(small);
+    rows[1].DOC.should.be.an.Object();
+    (await rows[1].DOC.getString()).should.be.eql(large);
+    await results.close();
+  });
+
+  it('32.3 streams LOBs in chunks', async () => {
+    const results = await connection.execute('SELECT DOC FROM LOB_TEST WHERE ID = 2', { lobStreamThreshold: 1024 });
+    const rows = await results.getRows();
+    let text = '';
+    let chunks = 0;
+    for await (const chunk of rows[0].DOC.stream()) {
+      text += chunk;
+      chunks++;
+    }
+    await results.close();
+    text.should.be.eql(large);
+    chunks.should.be.above(1);
+  });
+
+  it('32.4 fails to read LOBs once the result set is closed', async () => {
+    const results = await connection.execute('SELECT DOC FROM LOB_TEST WHERE ID = 2', { lobStreamThreshold: 1024 });
+    const rows = await results.getRows();
+    await results.close();
+    try {
+      await rows[0].DOC.read();
+      should.fail('read should have failed');
+    } catch (e) {
+      e.message.should.containEql('LOB is closed');
+    }
+  });
+});
@@ -0,0 +1,63 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, DecimalMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('33. Test Decimals', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS DECIMAL_TEST');
+    await connection.execute('CREATE TABLE DECIMAL_TEST (ID INTEGER, AMOUNT DECIMAL(38, 4))');
+    await connection.execute('INSERT INTO DECIMAL_TEST VALUES (1, 12.5)');
+    await connection.execute('INSERT INTO DECIMAL_TEST VALUES (2, -0.0001)');
+    await connection.execute('INSERT INTO DECIMAL_TEST VALUES (3, 12345678901234567.8901)');
+    await connection.execute('INSERT INTO DECIMAL_TEST VALUES (4, NULL)');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS DECIMAL_TEST');
+    await connection.close();
+  });
+
+  const selectAmounts = async (options) => {
+    const results = await connection.execute('SELECT AMOUNT FROM DECIMAL_TEST ORDER BY ID', options);
+    const rows = await results.getRows();
+    await results.close();
+    return rows.map((row) => row.AMOUNT);
+  };
+
+  it('33.1 returns strings by default', async () => {
+    const amounts = await selectAmounts();
+    amounts.should.be.eql(['12.5000', '-0.0001', '12345678901234567.8901', null]);
+  });
+
+  it('33.2 returns numbers that survive the conversion', async () => {
+    const amounts = await selectAmounts({ decimalMode: DecimalMode.DECIMALS_AS_NUMBER });
+    amounts.should.be.eql([12.5, -0.0001, '12345678901234567.8901', null]);
+  });
+
+  it('33.3 returns unscaled BigInts and scales', async () => {
+    const amounts = await selectAmounts({ decimalMode: DecimalMode.DECIMALS_AS_BIGINT });
+    // unscaled values beyond 64 bits remain strings
+    amounts.should.be.eql([[125000n, 4], [-1n, 4], '12345678901234567.8901', null]);
+  });
+});
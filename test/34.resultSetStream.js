@@ -0,0 +1,146 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+const { pipeline, Writable } = require('stream');
+const util = require('util');
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('34. Test Result Set Streams', () => {
+
+  var driver = null;
+  var connection = null;
+
+  const sql = 'SELECT COUNT(*) AS N FROM SYSTEM.TABLES';
+  const allSql = 'SELECT TABLENAME FROM SYSTEM.TABLES';
+  let total = 0;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    const results = await connection.execute(sql);
+    total = (await results.getRows())[0].N;
+    await results.close();
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+  });
+
+  it('34.1 iterates all rows with for await', async () => {
+    const results = await connection.execute(allSql);
+    let count = 0;
+    for await (const row of results) {
+      should.exist(row.TABLENAME);
+      count++;
+    }
+    count.should.be.eql(total);
+  });
+
+  it('34.2 closes the result set when leaving the loop early', async () => {
+    const results = await connection.execute(allSql);
+    for await (const row of results) {
+      should.exist(row);
+      break;
+    }
+    // the statement has been released, so the same SQL can run again
+    const again = await connection.execute(allSql);
+    (await again.getRows()).length.should.be.eql(total);
+    await again.close();
+  });
+
+  it('34.3 fetches batches only as they are consumed', async () => {
+    const batchSize = 5;
+    const results = await connection.execute(allSql);
+    let count = 0;
+    // the number of rows consumed when each batch was requested
+    const fetchedAt = [];
+    const observed = Object.create(results, {
+      _getBufferedRows: {
+        value: (...args) => {
+          const rows = results._getBufferedRows(...args);
+          if (rows !== undefined) {
+            fetchedAt.push(count);
+          }
+          return rows;
+        }
+      },
+      _getRows: {
+        value: (...args) => {
+          fetchedAt.push(count);
+          return results._getRows(...args);
+        }
+      }
+    });
+    await util.promisify(pipeline)(
+      results.stream.call(observed, { batchSize }),
+      new Writable({
+        objectMode: true,
+        highWaterMark: 1,
+        write: (row, encoding, callback) => {
+          count++;
+          setImmediate(callback);
+        }
+      })
+    );
+    count.should.be.eql(total);
+    fetchedAt.length.should.be.eql(Math.floor(total / batchSize) + 1);
+    // the read of the last row of a batch asks for the next one as the row
+    // is handed on, so at most that row is still pending
+    fetchedAt.forEach((consumed, batch) => consumed.should.be.aboveOrEqual(batch * batchSize - 1));
+  });
+
+  it('34.4 closes the result set when the stream is destroyed', async () => {
+    const results = await connection.execute(allSql);
+    const stream = results.stream({ batchSize: 1 });
+    await new Promise((resolve) => {
+      stream.once('data', () => {
+        stream.destroy();
+        stream.once('close', resolve);
+      });
+    });
+    stream.destroyed.should.be.true();
+  });
+
+  it('34.5 refuses to close a result set while rows are being fetched', async () => {
+    const results = await connection.execute(allSql);
+    // the native call queues its worker at once
+    const pending = new Promise((resolve, reject) => {
+      results._getRows(0, (err, rows) => (err ? reject(err) : resolve(rows)));
+    });
+    try {
+      await results.close();
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/already being read/);
+    }
+    (await pending).length.should.be.eql(total);
+    await results.close();
+  });
+
+  it('34.6 fails to read a result set once it is closing', async () => {
+    const results = await connection.execute(allSql);
+    // not awaited, so that the close is still running on a worker
+    const closing = results.close();
+    try {
+      await results.getRows();
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/result set is closed/);
+    }
+    await closing;
+  });
+});
@@ -0,0 +1,112 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('35. Test Result Set Export', () => {
+
+  var driver = null;
+  var connection = null;
+  var dir = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    dir = fs.mkdtempSync(path.join(os.tmpdir(), 'nuodb-export-'));
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+    fs.rmSync(dir, { recursive: true, force: true });
+  });
+
+  it('35.1 exports rows as CSV', async () => {
+    const file = path.join(dir, 'rows.csv');
+    const results = await connection.execute(
+      'SELECT 1 AS ID, \'a,"b"\' AS NAME, NULL AS EMPTY, 2.5 AS AMOUNT FROM DUAL');
+    const summary = await results.exportTo(file, { format: 'csv' });
+    await results.close();
+    summary.rows.should.be.eql(1);
+    const text = fs.readFileSync(file, 'utf8');
+    summary.bytes.should.be.eql(Buffer.byteLength(text));
+    text.should.be.eql('ID,NAME,EMPTY,AMOUNT\r\n1,"a,""b""",,2.5\r\n');
+  });
+
+  it('35.2 exports rows as NDJSON matching JSON.stringify', async () => {
+    const sql = 'SELECT TABLENAME, SCHEMA FROM SYSTEM.TABLES';
+    let results = await connection.execute(sql);
+    const rows = await results.getRows();
+    await results.close();
+
+    const file = path.join(dir, 'rows.ndjson');
+    results = await connection.execute(sql);
+    const summary = await results.exportTo(file, { format: 'ndjson' });
+    await results.close();
+    summary.rows.should.be.eql(rows.length);
+    const lines = fs.readFileSync(file, 'utf8').split('\n');
+    lines.pop().should.be.eql('');
+    lines.should.be.eql(rows.map((row) => JSON.stringify(row)));
+  });
+
+  it('35.3 writes to an open file descriptor and leaves it open', async () => {
+    const file = path.join(dir, 'fd.ndjson');
+    const fd = fs.openSync(file, 'w');
+    try {
+      const results = await connection.execute('SELECT \'line\nbreak\' AS TEXT FROM DUAL');
+      await results.exportTo(fd, { format: 'ndjson' });
+      await results.close();
+      fs.writeSync(fd, 'end\n');
+    } finally {
+      fs.closeSync(fd);
+    }
+    fs.readFileSync(file, 'utf8').should.be.eql('{"TEXT":"line\\nbreak"}\nend\n');
+  });
+
+  it('35.4 writes doubles as JavaScript does', async () => {
+    const sql = 'SELECT CAST(100000 AS DOUBLE) AS A, CAST(1E15 AS DOUBLE) AS B, CAST(1E-7 AS DOUBLE) AS C,' +
+      ' CAST(1E21 AS DOUBLE) AS D, CAST(0.000001 AS DOUBLE) AS E FROM DUAL';
+    const csv = path.join(dir, 'doubles.csv');
+    let results = await connection.execute(sql);
+    await results.exportTo(csv, { format: 'csv' });
+    await results.close();
+    fs.readFileSync(csv, 'utf8').should.be.eql('A,B,C,D,E\r\n100000,1000000000000000,1e-7,1e+21,0.000001\r\n');
+
+    results = await connection.execute(sql);
+    const rows = await results.getRows();
+    await results.close();
+    const ndjson = path.join(dir, 'doubles.ndjson');
+    results = await connection.execute(sql);
+    await results.exportTo(ndjson, { format: 'ndjson' });
+    await results.close();
+    fs.readFileSync(ndjson, 'utf8').should.be.eql(JSON.stringify(rows[0]) + '\n');
+  });
+
+  it('35.5 rejects an unknown format', async () => {
+    const results = await connection.execute('SELECT 1 AS ID FROM DUAL');
+    try {
+      await results.exportTo(path.join(dir, 'rows.xml'), { format: 'xml' });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/format/);
+    } finally {
+      await results.close();
+    }
+  });
+});
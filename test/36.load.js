@@ -0,0 +1,167 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('36. Test Bulk Load', () => {
+
+  var driver = null;
+  var connection = null;
+  var dir = null;
+
+  const selectAll = async () => {
+    const results = await connection.execute('SELECT ID, NAME, VALUE FROM LOAD_TEST ORDER BY ID');
+    const rows = await results.getRows();
+    await results.close();
+    return rows;
+  };
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    dir = fs.mkdtempSync(path.join(os.tmpdir(), 'nuodb-load-'));
+    await connection.execute('DROP TABLE IF EXISTS LOAD_TEST');
+    await connection.execute('CREATE TABLE LOAD_TEST (ID INTEGER, NAME STRING, VALUE DOUBLE)');
+  });
+
+  beforeEach('empty table', async () => {
+    await connection.execute('DELETE FROM LOAD_TEST');
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS LOAD_TEST');
+    await connection.close();
+    fs.rmSync(dir, { recursive: true, force: true });
+  });
+
+  it('36.1 loads a CSV file into a table in batches', async () => {
+    const file = path.join(dir, 'rows.csv');
+    let text = 'ID,NAME,VALUE\r\n';
+    for (let i = 0; i < 2500; i++) {
+      text += `${i},${i === 1 ? '"a,""b""\nc"' : i === 2 ? '' : i === 3 ? '""' : 'name' + i},${i / 2}\r\n`;
+    }
+    fs.writeFileSync(file, text);
+    const summary = await connection.loadFrom(file, { table: 'LOAD_TEST', batchSize: 1000 });
+    summary.rows.should.be.eql(2500);
+    const rows = await selectAll();
+    rows.length.should.be.eql(2500);
+    rows.slice(0, 5).should.be.eql([
+      { ID: 0, NAME: 'name0', VALUE: 0 },
+      { ID: 1, NAME: 'a,"b"\nc', VALUE: 0.5 },
+      { ID: 2, NAME: null, VALUE: 1 },
+      { ID: 3, NAME: '', VALUE: 1.5 },
+      { ID: 4, NAME: 'name4', VALUE: 2 },
+    ]);
+  });
+
+  it('36.2 loads an NDJSON file with explicit SQL', async () => {
+    const file = path.join(dir, 'rows.ndjson');
+    fs.writeFileSync(file, [
+      '{"ID":1,"NAME":"one","VALUE":1.25}',
+      '',
+      '{"VALUE":2,"ID":2}',
+      '{"ID":3,"NAME":"line\\nbreak \\u00e9","VALUE":null}',
+    ].join('\n'));
+    const summary = await connection.loadFrom(file, {
+      sql: 'INSERT INTO LOAD_TEST (ID, NAME, VALUE) VALUES (?, ?, ?)',
+      format: 'ndjson'
+    });
+    summary.rows.should.be.eql(3);
+    (await selectAll()).should.be.eql([
+      { ID: 1, NAME: 'one', VALUE: 1.25 },
+      { ID: 2, NAME: null, VALUE: 2 },
+      { ID: 3, NAME: 'line\nbreak é', VALUE: null },
+    ]);
+  });
+
+  it('36.3 round trips an export', async () => {
+    await connection.executeBatch('INSERT INTO LOAD_TEST VALUES (?, ?, ?)', [[1, 'x', 0.1], [2, null, 1e21]]);
+    const file = path.join(dir, 'export.csv');
+    const results = await connection.execute('SELECT ID, NAME, VALUE FROM LOAD_TEST');
+    await results.exportTo(file);
+    await results.close();
+    const before = await selectAll();
+    await connection.execute('DELETE FROM LOAD_TEST');
+    await connection.loadFrom(file, { table: 'LOAD_TEST' });
+    (await selectAll()).should.be.eql(before);
+  });
+
+  it('36.4 reports the line of a malformed record', async () => {
+    const file = path.join(dir, 'bad.csv');
+    fs.writeFileSync(file, 'ID,NAME,VALUE\n1,a,1\n2,b\n');
+    try {
+      await connection.loadFrom(file, { table: 'LOAD_TEST' });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/malformed record/);
+      e.message.should.match(/"Line": 3/);
+    }
+  });
+
+  it('36.5 requires a table or SQL', async () => {
+    try {
+      await connection.loadFrom(path.join(dir, 'rows.csv'), { format: 'csv' });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/table or sql/);
+    }
+  });
+
+  it('36.6 matches the table and columns regardless of case', async () => {
+    const file = path.join(dir, 'lower.csv');
+    fs.writeFileSync(file, 'id,name,value\n1,a,0.5\n');
+    await connection.loadFrom(file, { table: 'load_test' });
+    (await selectAll()).should.be.eql([{ ID: 1, NAME: 'a', VALUE: 0.5 }]);
+  });
+
+  it('36.7 rejects names that are not identifiers', async () => {
+    try {
+      await connection.loadFrom(path.join(dir, 'lower.csv'), { table: 'LOAD_TEST; DROP TABLE LOAD_TEST' });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/invalid value for property table/);
+    }
+    const file = path.join(dir, 'quoted.csv');
+    fs.writeFileSync(file, 'ID,"NAME"" ",VALUE\n1,a,0.5\n');
+    try {
+      await connection.loadFrom(file, { table: 'LOAD_TEST' });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/not an identifier/);
+      e.message.should.match(/"Column": 2/);
+    }
+  });
+
+  it('36.8 rolls back the rows of a failed batch', async () => {
+    const file = path.join(dir, 'partial.csv');
+    fs.writeFileSync(file, 'ID,NAME,VALUE\n1,a,1\n2,b,2\n3,c,3\n4,d,x\n');
+    connection.autoCommit = false;
+    try {
+      await connection.loadFrom(file, { table: 'LOAD_TEST', batchSize: 2 });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/failed to load rows/);
+    } finally {
+      await connection.commit();
+      connection.autoCommit = true;
+    }
+    (await selectAll()).map((row) => row.ID).should.be.eql([1, 2]);
+  });
+});
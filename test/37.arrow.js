@@ -0,0 +1,105 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+// messages splits an Arrow IPC stream into the sizes of its metadata and
+// bodies, checking the framing up to the end of stream marker.
+const messages = (buffer) => {
+  const found = [];
+  let offset = 0;
+  for (;;) {
+    buffer.readUInt32LE(offset).should.be.eql(0xFFFFFFFF);
+    const metadata = buffer.readInt32LE(offset + 4);
+    if (metadata === 0) {
+      (offset + 8).should.be.eql(buffer.length);
+      return found;
+    }
+    (metadata % 8).should.be.eql(0);
+    // the body length is the last field of the Message table
+    const message = buffer.subarray(offset + 8, offset + 8 + metadata);
+    const root = message.readUInt32LE(0);
+    const vtable = root - message.readInt32LE(root);
+    const bodyField = message.readUInt16LE(vtable + 4 + 2 * 3);
+    const body = Number(message.readBigInt64LE(root + bodyField));
+    found.push({ metadata, body });
+    offset += 8 + metadata + body;
+  }
+};
+
+describe('37. Test Arrow Output', () => {
+
+  var driver = null;
+  var connection = null;
+  var dir = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    dir = fs.mkdtempSync(path.join(os.tmpdir(), 'nuodb-arrow-'));
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+    fs.rmSync(dir, { recursive: true, force: true });
+  });
+
+  it('37.1 returns a schema, a record batch and the end of stream', async () => {
+    const results = await connection.execute(
+      'SELECT 1 AS ID, \'a\' AS NAME, NULL AS EMPTY, 2.5 AS AMOUNT FROM DUAL');
+    const buffer = await results.getArrow();
+    await results.close();
+    Buffer.isBuffer(buffer).should.be.true();
+    const found = messages(buffer);
+    found.length.should.be.eql(2);
+    found[0].body.should.be.eql(0);
+    found[1].body.should.be.above(0);
+    buffer.includes('AMOUNT').should.be.true();
+  });
+
+  it('37.2 returns only the schema for an empty result set', async () => {
+    const results = await connection.execute('SELECT TABLENAME FROM SYSTEM.TABLES WHERE 1 = 0');
+    const found = messages(await results.getArrow());
+    await results.close();
+    found.length.should.be.eql(1);
+  });
+
+  it('37.3 exports the stream to a file', async () => {
+    const file = path.join(dir, 'tables.arrow');
+    let results = await connection.execute('SELECT TABLENAME, SCHEMA FROM SYSTEM.TABLES');
+    const buffer = await results.getArrow();
+    await results.close();
+
+    results = await connection.execute('SELECT TABLENAME, SCHEMA FROM SYSTEM.TABLES');
+    const summary = await results.exportTo(file, { format: 'arrow' });
+    await results.close();
+    summary.bytes.should.be.eql(buffer.length);
+    fs.readFileSync(file).equals(buffer).should.be.true();
+  });
+
+  it('37.4 cannot load an Arrow file', async () => {
+    try {
+      await connection.loadFrom(path.join(dir, 'tables.arrow'), { table: 'T', format: 'arrow' });
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/format/);
+    }
+  });
+});
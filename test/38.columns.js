@@ -0,0 +1,108 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode, DecimalMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('38. Test Columns Row Mode', () => {
+
+  var driver = null;
+  var connection = null;
+
+  const sql = 'SELECT ID, S, B, D, N, NAME FROM COLUMNS_TEST ORDER BY ID';
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS COLUMNS_TEST');
+    await connection.execute(
+      'CREATE TABLE COLUMNS_TEST (ID INTEGER, S SMALLINT, B BIGINT, D DOUBLE, N NUMERIC(10,2), NAME STRING)');
+    await connection.executeBatch('INSERT INTO COLUMNS_TEST VALUES (?, ?, ?, ?, ?, ?)', [
+      [1, -2, '9223372036854775807', 0.5, '12.25', 'one'],
+      [2, null, null, null, null, null],
+      [3, 7, '-3', -1.5, '-0.01', 'three'],
+    ]);
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS COLUMNS_TEST');
+    await connection.close();
+  });
+
+  it('38.1 returns numeric columns as typed arrays with null bitmaps', async () => {
+    const results = await connection.execute(sql, { rowMode: RowMode.ROWS_AS_COLUMNS });
+    const { rows, columns, nulls } = await results.getRows();
+    await results.close();
+    rows.should.be.eql(3);
+    columns.ID.should.be.instanceOf(Int32Array);
+    Array.from(columns.ID).should.be.eql([1, 2, 3]);
+    columns.S.should.be.instanceOf(Int32Array);
+    Array.from(columns.S).should.be.eql([-2, 0, 7]);
+    columns.B.should.be.instanceOf(BigInt64Array);
+    Array.from(columns.B).should.be.eql([9223372036854775807n, 0n, -3n]);
+    columns.D.should.be.instanceOf(Float64Array);
+    Array.from(columns.D).should.be.eql([0.5, 0, -1.5]);
+    columns.N.should.be.eql(['12.25', null, '-0.01']);
+    columns.NAME.should.be.eql(['one', null, 'three']);
+
+    should(nulls.ID).be.null();
+    Array.from(nulls.S).should.be.eql([0b010]);
+    Array.from(nulls.D).should.be.eql([0b010]);
+    should(nulls.NAME).be.null();
+  });
+
+  it('38.2 returns decimals as a Float64Array in number mode', async () => {
+    const results = await connection.execute(sql, {
+      rowMode: RowMode.ROWS_AS_COLUMNS,
+      decimalMode: DecimalMode.DECIMALS_AS_NUMBER
+    });
+    const { columns } = await results.getRows();
+    await results.close();
+    columns.N.should.be.instanceOf(Float64Array);
+    Array.from(columns.N).should.be.eql([12.25, 0, -0.01]);
+  });
+
+  it('38.3 returns inexact decimals as an Array in number mode', async () => {
+    const results = await connection.execute('SELECT CAST(\'12345678901234567.125\' AS DECIMAL(20,3)) AS N FROM DUAL', {
+      rowMode: RowMode.ROWS_AS_COLUMNS,
+      decimalMode: DecimalMode.DECIMALS_AS_NUMBER
+    });
+    const { columns } = await results.getRows();
+    await results.close();
+    columns.N.should.be.eql(['12345678901234567.125']);
+  });
+
+  it('38.4 returns the requested number of rows per call', async () => {
+    const results = await connection.execute(sql, { rowMode: RowMode.ROWS_AS_COLUMNS });
+    const first = await results.getRows(2);
+    const rest = await results.getRows(2);
+    await results.close();
+    first.rows.should.be.eql(2);
+    Array.from(first.columns.ID).should.be.eql([1, 2]);
+    rest.rows.should.be.eql(1);
+    Array.from(rest.columns.ID).should.be.eql([3]);
+    should(rest.nulls.S).be.null();
+  });
+
+  it('38.5 streams batches of columns', async () => {
+    const results = await connection.execute(sql, { rowMode: RowMode.ROWS_AS_COLUMNS });
+    const batches = [];
+    for await (const batch of results.stream({ batchSize: 2 })) {
+      batches.push(batch.rows);
+    }
+    batches.should.be.eql([2, 1]);
+  });
+});
@@ -0,0 +1,94 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('39. Test JSON Row Mode', () => {
+
+  var driver = null;
+  var connection = null;
+
+  const sql = 'SELECT TABLENAME, SCHEMA, TABLEID FROM SYSTEM.TABLES ORDER BY TABLEID';
+
+  const selectRows = async (options, count) => {
+    const results = await connection.execute(sql, options);
+    const rows = await results.getRows(count);
+    await results.close();
+    return rows;
+  };
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+  });
+
+  it('39.1 returns the text JSON.stringify gives for the rows', async () => {
+    const rows = await selectRows({ rowMode: RowMode.ROWS_AS_OBJECT });
+    const json = await selectRows({ rowMode: RowMode.ROWS_AS_JSON });
+    json.should.be.type('string');
+    json.should.be.eql(JSON.stringify(rows));
+  });
+
+  it('39.2 writes dates, nulls and escapes as JSON.stringify does', async () => {
+    const results = await connection.execute(
+      'SELECT \'a"b\\\\\' AS TEXT, NULL AS EMPTY, CAST(\'2023-11-14 22:13:20.123\' AS TIMESTAMP) AS AT FROM DUAL',
+      { rowMode: RowMode.ROWS_AS_JSON });
+    const json = await results.getRows();
+    await results.close();
+    const rows = JSON.parse(json);
+    rows.length.should.be.eql(1);
+    rows[0].TEXT.should.be.eql('a"b\\');
+    should(rows[0].EMPTY).be.null();
+    new Date(rows[0].AT).should.be.instanceOf(Date);
+  });
+
+  it('39.3 returns an empty array once the rows are exhausted', async () => {
+    const results = await connection.execute(sql, { rowMode: RowMode.ROWS_AS_JSON });
+    const first = JSON.parse(await results.getRows(2));
+    first.length.should.be.eql(2);
+    await results.getRows();
+    (await results.getRows()).should.be.eql('[]');
+    await results.close();
+  });
+
+  it('39.4 streams the text of each batch', async () => {
+    const rows = await selectRows({ rowMode: RowMode.ROWS_AS_OBJECT });
+    const results = await connection.execute(sql, { rowMode: RowMode.ROWS_AS_JSON });
+    const streamed = [];
+    for await (const chunk of results.stream({ batchSize: 5 })) {
+      streamed.push(...JSON.parse(chunk));
+    }
+    streamed.should.be.eql(rows);
+  });
+
+  it('39.5 writes round and small doubles as JSON.stringify does', async () => {
+    const doubles = 'SELECT CAST(100000 AS DOUBLE) AS A, CAST(1E15 AS DOUBLE) AS B, CAST(1E-7 AS DOUBLE) AS C,' +
+      ' CAST(1E21 AS DOUBLE) AS D FROM DUAL';
+    let results = await connection.execute(doubles, { rowMode: RowMode.ROWS_AS_OBJECT });
+    const rows = await results.getRows();
+    await results.close();
+    results = await connection.execute(doubles, { rowMode: RowMode.ROWS_AS_JSON });
+    const json = await results.getRows();
+    await results.close();
+    json.should.be.eql('[{"A":100000,"B":1000000000000000,"C":1e-7,"D":1e+21}]');
+    json.should.be.eql(JSON.stringify(rows));
+  });
+});
@@ -0,0 +1,80 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver, RowMode } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+describe('40. Test Lazy Row Mode', () => {
+
+  var driver = null;
+  var connection = null;
+
+  const select = async (sql, options) => {
+    const results = await connection.execute(sql, options);
+    const rows = await results.getRows();
+    await results.close();
+    return rows;
+  };
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+  });
+
+  after('close connection', async () => {
+    await connection.close();
+  });
+
+  const wideSql = 'SELECT 1 AS A, \'b\' AS B, NULL AS C, 4.5 AS D, TRUE AS E FROM DUAL';
+
+  it('40.1 reads the columns of a row', async () => {
+    const [row] = await select(wideSql, { rowMode: RowMode.ROWS_AS_LAZY_OBJECT });
+    row.B.should.be.eql('b');
+    row.A.should.be.eql(1);
+    should(row.C).be.null();
+    should(row.MISSING).be.undefined();
+    ('D' in row).should.be.true();
+    ('MISSING' in row).should.be.false();
+  });
+
+  it('40.2 enumerates and serializes as object rows do', async () => {
+    const [row] = await select(wideSql, { rowMode: RowMode.ROWS_AS_LAZY_OBJECT });
+    Object.keys(row).should.be.eql(['A', 'B', 'C', 'D', 'E']);
+    JSON.stringify(row).should.be.eql('{"A":1,"B":"b","C":null,"D":4.5,"E":true}');
+    Object.assign({}, row).should.be.eql({ A: 1, B: 'b', C: null, D: 4.5, E: true });
+  });
+
+  it('40.3 matches object rows across batches', async () => {
+    const sql = 'SELECT TABLENAME, SCHEMA, TABLEID FROM SYSTEM.TABLES ORDER BY TABLEID';
+    const rows = await select(sql, { rowMode: RowMode.ROWS_AS_OBJECT });
+    const lazy = await select(sql, { rowMode: RowMode.ROWS_AS_LAZY_OBJECT });
+    lazy.map((row) => Object.assign({}, row)).should.be.eql(rows);
+  });
+
+  it('40.4 keeps assigned values', async () => {
+    const [row] = await select(wideSql, { rowMode: RowMode.ROWS_AS_LAZY_OBJECT });
+    row.A = 'changed';
+    row.EXTRA = 2;
+    row.A.should.be.eql('changed');
+    row.EXTRA.should.be.eql(2);
+  });
+
+  it('40.5 keeps the last of duplicate column names', async () => {
+    const [row] = await select('SELECT 1 AS X, 2 AS X FROM DUAL', { rowMode: RowMode.ROWS_AS_LAZY_OBJECT });
+    row.X.should.be.eql(2);
+    Object.keys(row).should.be.eql(['X']);
+  });
+});
@@ -0,0 +1,131 @@
+// Copyright 2023, Dassault Systèmes SE
+// All rights reserved.
+//
+// Redistribution and use permitted under the terms of the 3-clause BSD license.
+
+'use strict';
+
+var { Driver } = require('..');
+
+var should = require('should');
+const nconf = require('nconf');
+const args = require('yargs').argv;
+
+// Setup order for test parameters and default configuration file
+nconf.argv({parseValues:true}).env({parseValues:true}).file({ file: args.config||'test/config.json' });
+
+var DBConnect = nconf.get('DBConnect');
+
+const getCounter = (name) => {
+  const snapshot = JSON.parse(Driver.getAsyncJSON())[0];
+  return snapshot.counters.find((counter) => counter.name === name);
+};
+
+const ROW_COUNT = 5000;
+
+describe('41. Test Result Set Limits', () => {
+
+  var driver = null;
+  var connection = null;
+
+  before('open connection', async () => {
+    driver = new Driver();
+    connection = await driver.connect(DBConnect);
+    connection.should.be.ok();
+    await connection.execute('DROP TABLE IF EXISTS LIMIT_TEST');
+    await connection.execute('CREATE TABLE LIMIT_TEST (ID INTEGER, NAME STRING)');
+    const ids = new Int32Array(ROW_COUNT).map((_, i) => i);
+    const names = Array.from(ids, (i) => 'name' + i);
+    await connection.executeColumns('INSERT INTO LIMIT_TEST VALUES (?, ?)', [ids, names]);
+  });
+
+  after('close connection', async () => {
+    await connection.execute('DROP TABLE IF EXISTS LIMIT_TEST');
+    await connection.close();
+  });
+
+  it('41.1 stops a query at maxRows', async () => {
+    const results = await connection.execute('SELECT ID FROM LIMIT_TEST ORDER BY ID', { maxRows: 10 });
+    const rows = await results.getRows();
+    await results.close();
+    rows.length.should.be.eql(10);
+  });
+
+  it('41.2 does not carry maxRows over to a cached statement', async () => {
+    const sql = 'SELECT ID FROM LIMIT_TEST';
+    let results = await connection.execute(sql, { maxRows: 10 });
+    (await results.getRows()).length.should.be.eql(10);
+    await results.close();
+    results = await connection.execute(sql);
+    (await results.getRows()).length.should.be.eql(ROW_COUNT);
+    await results.close();
+  });
+
+  it('41.3 applies maxRows to prepared statements', async () => {
+    const statement = await connection.prepare('SELECT ID FROM LIMIT_TEST WHERE ID >= ?', { maxRows: 5 });
+    const results = await statement.execute([100]);
+    const rows = await results.getRows();
+    await results.close();
+    await statement.close();
+    rows.length.should.be.eql(5);
+  });
+
+  it('41.4 fails getRows beyond maxBufferedBytes', async () => {
+    const results = await connection.execute('SELECT ID, NAME FROM LIMIT_TEST ORDER BY ID', { maxBufferedBytes: 4096 });
+    try {
+      await results.getRows();
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/rows exceed maxBufferedBytes/);
+      e.message.should.match(/"Limit": 4096/);
+    }
+    // the rows fetched so far are still returned by smaller requests
+    const rows = await results.getRows(10);
+    await results.close();
+    rows.should.be.eql(Array.from({ length: 10 }, (_, i) => ({ ID: i, NAME: 'name' + i })));
+  });
+
+  it('41.5 bounds all the batches of a request by maxBufferedBytes', async () => {
+    const results = await connection.execute('SELECT ID, NAME FROM LIMIT_TEST', { maxBufferedBytes: 64 * 1024 });
+    try {
+      await results.getRows();
+      should.fail('expected an error');
+    } catch (e) {
+      e.message.should.match(/rows exceed maxBufferedBytes/);
+    }
+    await results.close();
+  });
+
+  it('41.6 pages through rows within maxBufferedBytes', async () => {
+    const results = await connection.execute('SELECT ID FROM LIMIT_TEST', { maxBufferedBytes: 64 * 1024 });
+    let count = 0;
+    let rows;
+    while ((rows = await results.getRows(100)).length > 0) {
+      count += rows.length;
+    }
+    await results.close();
+    count.should.be.eql(ROW_COUNT);
+  });
+
+  it('41.7 reports the buffered bytes', async () => {
+    const before = getCounter('BUFFERED_BYTES');
+    const results = await connection.execute('SELECT ID, NAME FROM LIMIT_TEST', { fetchSize: 1000 });
+    getCounter('BUFFERED_BYTES').total.should.be.above(before.total);
+    await results.close();
+    getCounter('BUFFERED_BYTES').current.should.be.eql(before.current);
+  });
+
+  it('41.8 takes maxBufferedBytes beyond 32 bits', async () => {
+    const results = await connection.execute('SELECT ID FROM LIMIT_TEST', { maxBufferedBytes: 8 * 1024 * 1024 * 1024 });
+    (await results.getRows()).length.should.be.eql(ROW_COUNT);
+    await results.close();
+    for (const maxBufferedBytes of [-1, 0.5, 2 ** 53]) {
+      try {
+        await connection.execute('SELECT ID FROM LIMIT_TEST', { maxBufferedBytes });
+        should.fail('expected an error');
+      } catch (e) {
+        e.message.should.match(/invalid type for property maxBufferedBytes/);
+      }
+    }
+  });
+});
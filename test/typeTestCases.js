@@ -10,12 +10,11 @@ const testCases = [
       16
     ],
     checkResults: (rows) => {
-      // nuodb returns each byte as a string in hexadecimal format, nodejs converts strings to decimal by default
-      // Using string constants here to avoid needing to include an additional library for this test.
-      (rows).should.containEql({F1:'00'});
-      (rows).should.containEql({F1:'01'});
-      (rows).should.containEql({F1:'0A'});
-      (rows).should.containEql({F1:'10'});
+      // binary values are returned as Buffers of their bytes
+      (rows).should.containEql({F1:Buffer.from([0x00])});
+      (rows).should.containEql({F1:Buffer.from([0x01])});
+      (rows).should.containEql({F1:Buffer.from([0x0A])});
+      (rows).should.containEql({F1:Buffer.from([0x10])});
     }
   },
   {
@@ -26,10 +25,9 @@ const testCases = [
       "abcd",
     ],
     checkResults: (rows) => {
-      // nuodb returns the string data as a string in hexadecimal format, nodejs converts strings to decimal by default
-      // Using string constants here to avoid needing to include an additional library for this test.
-      (rows).should.containEql({F1:'31323334'});
-      (rows).should.containEql({F1:'61626364'});
+      // binary values are returned as Buffers of their bytes
+      (rows).should.containEql({F1:Buffer.from('1234')});
+      (rows).should.containEql({F1:Buffer.from('abcd')});
     }
   },
   {
@@ -64,8 +62,8 @@ const testCases = [
       null,
     ],
     checkResults: (rows) => {
-      (rows).should.containEql({F1:'31323334'});
-      (rows).should.containEql({F1:'61626364'});
+      (rows).should.containEql({F1:Buffer.from('1234')});
+      (rows).should.containEql({F1:Buffer.from('abcd')});
       (rows).should.containEql({F1: null});
     }
   },